@@ -5,11 +5,6 @@
 #include "ResourceHolder.h"
 #include "PreprocessorDirectves.h"
 
-static const std::string S_DEFAULT_FONT{ "Font_consola" };
-static const sf::Color S_DEFAULT_TEXT_FILL_COLOR{ 25,25,25 };
-static const sf::Color S_DEFAILT_TEXT_OUTILINE_COLOR{ 250,250,250 };
-static const unsigned S_DEFAULT_TEXT_SIZE{ 2U };
-
 
 ////////////////////////////////////////////////////////////
 Actor_Base::Actor_Base(
@@ -21,16 +16,30 @@ Actor_Base::Actor_Base(
 	const sf::IntRect& t_spriteRect,
 	bool t_isSpriteVisible,
 	bool t_isTextVisible) :
-	m_context{ t_context },
 	m_position{ t_position },
 	m_rotation{ t_rotation },
+	m_prevPosition{ t_position },
+	m_prevRotation{ t_rotation },
 	m_color{ t_color },
+	m_collider{ std::make_unique<Collider>(this, t_position, sf::Vector2f(0.f,0.f)) },
+	m_context{ t_context },
 	m_isSpriteVisible{ t_isSpriteVisible },
 	m_isTextVisible{ t_isTextVisible },
 	m_actorType{ ActorType::Base },
-	m_collider{ std::make_unique<Collider>(this, t_position, sf::Vector2f(0.f,0.f)) }
+	m_destroy{ false }
 {
 
+	// Headless actors have no texture nor label; the texture rect alone gives the sprite its bounds (radius, collider)
+	if (m_context.m_isHeadless) {
+		sf::Vector2u textureSize;
+		if (!m_context.m_resourceHolder->getTextureSize(t_texture, textureSize)) {
+			throw(std::runtime_error(std::string("Actor_Base::Actor_Base: Texture " + t_texture + " size is unknown!")));
+		}
+		m_sprite.setTextureRect((t_spriteRect.width && t_spriteRect.height) ? t_spriteRect : sf::IntRect(0, 0, textureSize.x, textureSize.y));
+		m_isTextVisible = false;
+		return;
+	}
+
 	// Initialize texture
 	Resource* texture_resource{ m_context.m_resourceHolder->getResource(ResourceType::Texture, t_texture) };
 	if (!texture_resource) {
@@ -44,34 +53,32 @@ Actor_Base::Actor_Base(
 	auto& spriteSize{ m_sprite.getTextureRect() };
 	m_sprite.setOrigin(static_cast<float>(spriteSize.width) / 2, static_cast<float>(spriteSize.height) / 2);
 
-	// Initialize text
-	Resource* font_resource{ m_context.m_resourceHolder->getResource(ResourceType::Font, S_DEFAULT_FONT) };
-	if (!font_resource) {
-		throw(std::runtime_error(std::string("Organism::Organims: Font " + S_DEFAULT_FONT + " was nullptr!")));
-	}
-	m_text.setFont(std::get<sf::Font>(*font_resource));
-	m_text.setFillColor(S_DEFAULT_TEXT_FILL_COLOR);
-	m_text.setOutlineColor(S_DEFAILT_TEXT_OUTILINE_COLOR);
-
-	update(0.f); // Set sprite, text position, and collider aabb
-
 #if IS_DISPLAY_ACTOR_TAGS == 0
 	m_isTextVisible = false;
 #endif// IS_DISPLAY_ACTOR_TAGS == 0
 }
 
+////////////////////////////////////////////////////////////
+void Actor_Base::reinitialize(const sf::Vector2f& t_position, const float& t_rotation, const sf::Color& t_color) {
+	m_position = m_prevPosition = t_position;
+	m_rotation = m_prevRotation = t_rotation;
+	m_color = t_color;
+	m_destroy = false;
+	m_collider->update(this, t_position, sf::Vector2f(0.f, 0.f));
+}
+
 ////////////////////////////////////////////////////////////
 const sf::Vector2f& Actor_Base::getPosition()const { return m_position; }
 
 ////////////////////////////////////////////////////////////
-void Actor_Base::setPosition(const sf::Vector2f& t_position) { m_position = t_position; }
+void Actor_Base::setPosition(const sf::Vector2f& t_position) { m_position = m_prevPosition = t_position; } // Teleport; nothing to interpolate
 
 ////////////////////////////////////////////////////////////
 const float& Actor_Base::getRotation()const { return m_rotation; }
 
 ////////////////////////////////////////////////////////////
 void Actor_Base::setRotation(const float& t_rotation) {
-	m_rotation = mat::normalizeAngle(t_rotation);
+	m_rotation = m_prevRotation = mat::normalizeAngle(t_rotation);
 }
 
 ////////////////////////////////////////////////////////////
@@ -125,31 +132,50 @@ const Collider& Actor_Base::getCollider()const { return *m_collider.get(); }
 
 
 ////////////////////////////////////////////////////////////
-void Actor_Base::draw() {
+void Actor_Base::draw(SpriteBatch& t_sprites) {
 	if (m_isSpriteVisible) {
-		m_context.m_window->draw(m_sprite);
-	}
-	if (m_isTextVisible) {
-		m_context.m_window->draw(m_text);
+		t_sprites.add(m_sprite);
 	}
 }
 
+////////////////////////////////////////////////////////////
+void Actor_Base::drawLabel(LabelRenderer& t_labels) {
+	if (!m_isTextVisible) { return; }
+	updateLabel();
+	const sf::Vector2f& position{ m_sprite.getPosition() }; // Interpolated
+	t_labels.add(m_label, { position.x, position.y - m_sprite.getGlobalBounds().height * 0.7f }); // Just above the sprite (-y = up)
+}
+
+////////////////////////////////////////////////////////////
+void Actor_Base::updateLabel() {}
+
 ////////////////////////////////////////////////////////////
 const ActorType& Actor_Base::getActorType()const { return m_actorType; }
 
 
 ////////////////////////////////////////////////////////////
-void Actor_Base::update(const float& t_elapsed) {
-	// Update sprite
-	m_sprite.setRotation(m_rotation);
-	m_sprite.setPosition(m_position);
-	m_sprite.setColor(m_color);
+void Actor_Base::update(const float& t_elapsed) {} // The sprite and label follow when drawn, see interpolateTransform and drawLabel
 
-	// Put text origin in text's center (just in case it changes of string; remember this is a base)
-	utilities::centerSFMLText(m_text);
+////////////////////////////////////////////////////////////
+void Actor_Base::storePreviousTransform() {
+	m_prevPosition = m_position;
+	m_prevRotation = m_rotation;
+}
 
-	// Put text above sprite (-y = up; +y = down):
-	m_text.setPosition(m_position.x, m_position.y - (m_sprite.getGlobalBounds().height * 1.4f + utilities::getSFMLTextMaxHeight(m_text)) / 2); // 
+////////////////////////////////////////////////////////////
+void Actor_Base::interpolateTransform(const float& t_alpha) {
+	sf::Vector2f position{ mat::vec2d_lerp(m_prevPosition, m_position, t_alpha) };
+
+	// Turn through the shortest arc
+	float rotationDelta{ m_rotation - m_prevRotation };
+	if (rotationDelta > 180.f) { rotationDelta -= 360.f; }
+	else if (rotationDelta < -180.f) { rotationDelta += 360.f; }
+
+	const float scale{ getScale() };
+	m_sprite.setPosition(position);
+	m_sprite.setRotation(mat::normalizeAngle(m_prevRotation + rotationDelta * t_alpha));
+	m_sprite.setScale(scale, scale);
+	if (m_sprite.getColor() != m_color) { m_sprite.setColor(m_color); }
 }
 
 ////////////////////////////////////////////////////////////
@@ -174,10 +200,13 @@ bool Actor_Base::shouldBeDestroyed()const { return m_destroy; }
 void Actor_Base::setShouldBeDestroyed(bool t_destroy) { m_destroy = t_destroy; }
 
 ////////////////////////////////////////////////////////////
-void Actor_Base::setTextString(const std::string& t_str) { m_text.setString(t_str); utilities::centerSFMLText(m_text); }
+void Actor_Base::setTextString(const std::string& t_str) {
+	if (m_context.m_isHeadless) { return; }
+	m_label.setText(t_str); // Laid out by the label renderer; no glyph is touched here, so workers may call this
+}
 
 ////////////////////////////////////////////////////////////
-std::string Actor_Base::getTextString()const { return m_text.getString(); }
+std::string Actor_Base::getTextString()const { return m_label.getText(); }
 
 ////////////////////////////////////////////////////////////
 bool Actor_Base::canSpawn(SharedContext& t_context) const{ return true;}
@@ -193,3 +222,6 @@ void Actor_Base::onDestruction(SharedContext& t_context) {}
 
 ////////////////////////////////////////////////////////////
 float Actor_Base::getRadius()const { return m_sprite.getLocalBounds().width*0.5f; }
+
+////////////////////////////////////////////////////////////
+float Actor_Base::getScale()const { return 1.f; }
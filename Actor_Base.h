@@ -4,9 +4,10 @@
 #include <memory>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Sprite.hpp>
-#include <SFML/Graphics/Text.hpp>
 #include "CollisionManager.h"
 #include "Collider.h"
+#include "LabelRenderer.h"
+#include "SpriteBatch.h"
 
 struct SharedContext;
 class Actor_Base;
@@ -15,7 +16,8 @@ using ActorPtr = std::unique_ptr<Actor_Base>;
 enum class ActorType {
 	Base,
 	Organism,
-	Food
+	Food,
+	COUNT // Not a type; sizes tables indexed by type
 };
 
 class Actor_Base {
@@ -23,9 +25,11 @@ class Actor_Base {
 protected:
 	sf::Vector2f m_position;
 	float m_rotation; // [0 360)
+	sf::Vector2f m_prevPosition; // Transform at the start of the current tick; used to interpolate between ticks when drawing
+	float m_prevRotation;
 	sf::Sprite m_sprite;
 	sf::Color m_color;
-	sf::Text m_text;
+	Label m_label; // Nametag
 	std::unique_ptr<Collider> m_collider;
 	SharedContext& m_context;
 	bool m_isSpriteVisible;
@@ -45,10 +49,11 @@ public:
 		const sf::IntRect& t_spriteRect,
 		bool t_isSpriteVisible = true,
 		bool t_isTextVisible = true);
+	virtual ~Actor_Base() {} // Actors are owned and destroyed through ActorPtr
 	const sf::Vector2f& getPosition()const;
-	void setPosition(const sf::Vector2f& t_position);
+	virtual void setPosition(const sf::Vector2f& t_position);
 	const float& getRotation()const;
-	void setRotation(const float& t_rotation);
+	virtual void setRotation(const float& t_rotation);
 	const sf::Color& getColor()const;
 	void setColor(const sf::Color& t_color);
 	const sf::Sprite& getSprite()const;
@@ -73,12 +78,26 @@ public:
 
 	virtual void update(const float& t_elapsed);
 	virtual void updateCollider();
-	virtual void draw();
+	virtual void draw(SpriteBatch& t_sprites); // Adds the sprite to the frame's batch
+	void drawLabel(LabelRenderer& t_labels); // Labels go over every sprite, after the batch
+
+	void storePreviousTransform(); // Called at the start of every simulation tick
+	// Brings the sprite up to date for drawing, placed between the previous and current transforms.
+	//	The simulation never touches them, so only the actors drawn in a frame pay for it.
+	void interpolateTransform(const float& t_alpha);
 
 	virtual bool canSpawn(SharedContext& t_context)const;
 	virtual ActorPtr clone();
 	virtual void onSpawn(SharedContext& t_context);
 	virtual void onDestruction(SharedContext& t_context); // Anything that happens when the actor is aihiated i. g. spawning something
 	virtual float getRadius()const;
+	virtual float getScale()const; // Of the sprite
+
+protected:
+	virtual void updateLabel(); // Writes the numeric fields of the label, right before it is drawn
+
+protected:
+	void reinitialize(const sf::Vector2f& t_position, const float& t_rotation, const sf::Color& t_color); // Resets a recycled actor as if just constructed, keeping its texture, font and collider
+
 };
 #endif // !ACTOR_BASE_H
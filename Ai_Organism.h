@@ -4,14 +4,11 @@
 #include "Ai_Base.h"
 
 class Actor_Base;
-struct SharedContext;
 
+// Idle movement runs in the engine's OrganismStore; the per-organism ai only decides on reproduction
 class Ai_Organism : public Ai_Base {
-
-	float m_noiseIncrement;
-
 public:
-	Ai_Organism(SharedContext& t_context);
+	Ai_Organism();
 	void update(Actor_Base* t_owner, const float& t_elapsed);
 
 };
@@ -0,0 +1,17 @@
+#include "AllocationCounter.h"
+
+// Constant initialized: ready before any dynamic initialization allocates
+std::atomic<std::uint64_t> AllocationCounter::s_numAllocations{ 0U };
+std::atomic<bool> AllocationCounter::s_isCounting{ false };
+
+////////////////////////////////////////////////////////////
+std::uint64_t AllocationCounter::getCount() { return s_numAllocations.load(std::memory_order_relaxed); }
+
+////////////////////////////////////////////////////////////
+bool AllocationCounter::isCounting() { return s_isCounting.load(std::memory_order_relaxed); }
+
+////////////////////////////////////////////////////////////
+void AllocationCounter::addAllocation() { s_numAllocations.fetch_add(1U, std::memory_order_relaxed); }
+
+////////////////////////////////////////////////////////////
+void AllocationCounter::setCounting() { s_isCounting.store(true, std::memory_order_relaxed); }
@@ -0,0 +1,23 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Number of calls to the global operator new since the program started, so benchmarks can tell how much a piece
+//	of code allocates. Only executables that link AllocationHooks.cpp with IS_COUNT_ALLOCATIONS 1 (the benchmark
+//	runner) replace the global operator new; everywhere else allocations take no detour and nothing is counted.
+class AllocationCounter {
+	static std::atomic<std::uint64_t> s_numAllocations;
+	static std::atomic<bool> s_isCounting;
+
+public:
+	static std::uint64_t getCount(); // Always 0 when not counting
+	static bool isCounting();
+
+	// For the replaced operator new
+	static void addAllocation();
+	static void setCounting();
+};
+
+#endif // !ALLOCATION_COUNTER_H
@@ -0,0 +1,26 @@
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.h"
+#include "PreprocessorDirectves.h"
+
+// Replaces the global operator new of the executable it is linked into. Kept out of the engine library, so only
+//	the benchmark runner pays for the shared counter; the app and the headless runner allocate as usual.
+#if IS_COUNT_ALLOCATIONS == 1
+
+////////////////////////////////////////////////////////////
+static const bool S_IS_COUNTING{ (AllocationCounter::setCounting(), true) };
+
+////////////////////////////////////////////////////////////
+void* operator new(std::size_t t_size) {
+	AllocationCounter::addAllocation();
+	if (void* ptr{ std::malloc(t_size ? t_size : 1U) }) { return ptr; }
+	throw std::bad_alloc();
+}
+
+////////////////////////////////////////////////////////////
+void operator delete(void* t_ptr) noexcept { std::free(t_ptr); }
+
+////////////////////////////////////////////////////////////
+void operator delete(void* t_ptr, std::size_t) noexcept { std::free(t_ptr); }
+
+#endif // IS_COUNT_ALLOCATIONS == 1
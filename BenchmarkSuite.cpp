@@ -0,0 +1,308 @@
+#include "BenchmarkSuite.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "AllocationCounter.h"
+#include "CircleBatch.h"
+#include "CollisionManager.h"
+#include "Collider.h"
+#include "Engine.h"
+#include "HeightMap.h"
+#include "Organism.h"
+#include "PerlinNoise.h"
+#include "RandomGenerator.h"
+#include "Trait.h"
+#include "TraitCollection.h"
+
+static const unsigned S_VERSION{ 1U }; // Of the JSON layout
+static const std::uint64_t S_SEED{ 42U };
+static const std::vector<unsigned> S_ACTOR_COUNTS{ 1000U, 10000U, 100000U };
+static const unsigned long long S_ACTOR_TICKS{ 200000U }; // Ticks timed per scenario are this over the actor count, at least S_MIN_TICKS
+static const unsigned long long S_MIN_TICKS{ 5U };
+static const unsigned long long S_WARM_UP_TICKS{ 5U };
+static const float S_AREA_PER_ACTOR{ 3000.f * 3000.f / 215.f }; // Density of the standard scenario
+static const float S_MIN_SIZE{ 8.f };
+static const float S_MAX_SIZE{ 40.f };
+static const unsigned long long S_MICRO_ITERATIONS{ 1000000U };
+static const unsigned S_CIRCLE_CHECK_ROUNDS{ 2000U };
+static const unsigned S_CIRCLE_CHECK_MAX_SIZE{ 41U }; // Batch sizes up to this cover every split between lanes and the scalar loop
+static const unsigned S_HEIGHT_MAP_SIDE{ 256U };
+static const unsigned long long S_HEIGHT_MAP_ITERATIONS{ 50U };
+
+struct BenchmarkResult {
+	std::string m_name;
+	unsigned long long m_iterations;
+	double m_nsPerIteration;
+	double m_allocationsPerIteration;
+};
+
+static volatile float s_sink{ 0.f }; // Results are written here so the optimizer can't drop the work
+
+
+////////////////////////////////////////////////////////////
+template<typename Fn>
+static BenchmarkResult measure(const std::string& t_name, const unsigned long long& t_iterations, Fn&& t_fn) {
+	const std::uint64_t allocations{ AllocationCounter::getCount() };
+	const auto start{ std::chrono::steady_clock::now() };
+	for (unsigned long long i{ 0U }; i < t_iterations; i++) { t_fn(i); }
+	const double ns{ std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() };
+	const double numAllocations{ static_cast<double>(AllocationCounter::getCount() - allocations) };
+
+	BenchmarkResult result{ t_name, t_iterations, ns / t_iterations, numAllocations / t_iterations };
+	std::cout << std::left << std::setw(36) << result.m_name << std::right << std::fixed
+		<< std::setw(16) << std::setprecision(1) << result.m_nsPerIteration << " ns"
+		<< std::setw(12) << std::setprecision(2) << result.m_allocationsPerIteration << " allocs" << std::endl;
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+static void benchmarkSimulation(std::vector<BenchmarkResult>& t_out_results) {
+	for (const auto& count : S_ACTOR_COUNTS) {
+		// The standard scenario, scaled: same density, same share of organisms, food and energy per actor
+		const float scale{ count / 215.f };
+		ScenarioSettings settings;
+		settings.m_energy *= scale;
+		settings.m_numOrganisms = static_cast<unsigned>(settings.m_numOrganisms * scale);
+		settings.m_maxNumOrganisms = static_cast<unsigned>(settings.m_maxNumOrganisms * scale);
+		settings.m_numFood = count - settings.m_numOrganisms;
+		settings.m_width = settings.m_height = std::sqrt(count * S_AREA_PER_ACTOR);
+
+		Engine engine{ sf::Vector2u(1080,1080), "Benchmark", true, JobSystem::getDefaultNumWorkers(), S_SEED, "", settings };
+		engine.setState(EngineState::Running);
+		for (unsigned long long i{ 0U }; i < S_WARM_UP_TICKS; i++) { engine.update(); }
+
+		const unsigned long long ticks{ std::max(S_ACTOR_TICKS / count, S_MIN_TICKS) };
+		t_out_results.push_back(measure("simulation/tick/" + std::to_string(count), ticks, [&engine](const unsigned long long&) { engine.update(); }));
+	}
+}
+
+////////////////////////////////////////////////////////////
+static void benchmarkQuadtree(std::vector<BenchmarkResult>& t_out_results) {
+	for (const auto& count : S_ACTOR_COUNTS) {
+		const float side{ std::sqrt(count * S_AREA_PER_ACTOR) };
+		RandomGenerator rng{ S_SEED };
+		std::vector<std::unique_ptr<Collider>> colliders;
+		colliders.reserve(count);
+		for (unsigned i{ 0U }; i < count; i++) {
+			const float size{ rng(S_MIN_SIZE, S_MAX_SIZE) };
+			colliders.emplace_back(std::make_unique<Collider>(nullptr, sf::Vector2f(rng(0.f, side), rng(0.f, side)), sf::Vector2f(size, size)));
+		}
+		auto quadtree{ CollisionManager::makeBroadPhase(BroadPhaseType::Quadtree, { 0.f, 0.f, side, side }) };
+
+		for (auto& collider : colliders) { quadtree->insert(collider.get()); } // The nodes it needs are there from now on
+		quadtree->clear();
+		t_out_results.push_back(measure("quadtree/insert/" + std::to_string(count), count, [&quadtree, &colliders](const unsigned long long& t_i) {
+			quadtree->insert(colliders[static_cast<std::size_t>(t_i)].get());
+		}));
+		quadtree->update();
+
+		Objects found;
+		t_out_results.push_back(measure("quadtree/query/" + std::to_string(count), count, [&quadtree, &colliders, &found](const unsigned long long& t_i) {
+			const auto center{ colliders[static_cast<std::size_t>(t_i)]->getCenterPos() };
+			found.clear();
+			quadtree->getPotentialOverlaps(found, { center.x - S_MAX_SIZE, center.y - S_MAX_SIZE, 2.f * S_MAX_SIZE, 2.f * S_MAX_SIZE });
+			s_sink = s_sink + static_cast<float>(found.size());
+		}));
+		quadtree->clear();
+	}
+}
+
+////////////////////////////////////////////////////////////
+static void benchmarkTraits(std::vector<BenchmarkResult>& t_out_results) {
+	const TraitCollection& traits{ Trait_Base::getDefaultTraits() };
+	std::vector<TraitId> ids;
+	for (std::size_t i{ 0U }; i < NUM_TRAITS; i++) {
+		if (Trait_Base::isTraitFloat(static_cast<TraitId>(i))) { ids.push_back(static_cast<TraitId>(i)); }
+	}
+
+	t_out_results.push_back(measure("traits/get_value", S_MICRO_ITERATIONS, [&traits, &ids](const unsigned long long& t_i) {
+		s_sink = s_sink + traits.getValue(ids[t_i % ids.size()]);
+	}));
+	t_out_results.push_back(measure("traits/get_trait_value", S_MICRO_ITERATIONS, [&traits, &ids](const unsigned long long& t_i) {
+		float value{ 0.f };
+		traits.getTraitValue(ids[t_i % ids.size()], value);
+		s_sink = s_sink + value;
+	}));
+}
+
+////////////////////////////////////////////////////////////
+static void benchmarkReproduction(std::vector<BenchmarkResult>& t_out_results) {
+	Engine engine{ sf::Vector2u(1080,1080), "Benchmark", true, 0U, S_SEED };
+	OrganismStore& store{ engine.getOrganismStore() };
+	Organism* parent{ nullptr };
+	for (unsigned slot{ 0U }; slot < store.size() && !parent; slot++) {
+		if (store.isSpawned(slot)) { parent = store.getOwners()[slot]; }
+	}
+	if (!parent) { return; }
+
+	// A boom: births only, every one out of the organisms the engine constructed up front
+	SharedContext& context{ engine.getContext() };
+	std::vector<ActorPtr> offspring;
+	const std::size_t numBirths{ store.getPoolSize() };
+	offspring.reserve(numBirths);
+	t_out_results.push_back(measure("organism/reproduce", numBirths, [parent, &context, &offspring](const unsigned long long&) {
+		offspring.emplace_back(parent->reproduce(context));
+	}));
+}
+
+////////////////////////////////////////////////////////////
+static void benchmarkPerlinNoise(std::vector<BenchmarkResult>& t_out_results) {
+	PerlinNoise::resetPermutationList(S_SEED);
+	t_out_results.push_back(measure("perlin/noise_1d", S_MICRO_ITERATIONS, [](const unsigned long long& t_i) {
+		s_sink = s_sink + PerlinNoise::noise(t_i * 0.01f);
+	}));
+	t_out_results.push_back(measure("perlin/noise_2d", S_MICRO_ITERATIONS, [](const unsigned long long& t_i) {
+		s_sink = s_sink + PerlinNoise::noise(t_i * 0.01f, t_i * 0.007f);
+	}));
+	t_out_results.push_back(measure("perlin/noise_3d", S_MICRO_ITERATIONS, [](const unsigned long long& t_i) {
+		s_sink = s_sink + PerlinNoise::noise(t_i * 0.01f, t_i * 0.007f, t_i * 0.003f);
+	}));
+}
+
+////////////////////////////////////////////////////////////
+static void benchmarkHeightMap(std::vector<BenchmarkResult>& t_out_results) {
+	const unsigned side{ S_HEIGHT_MAP_SIDE };
+	std::vector<double> values(side * side);
+	for (unsigned y{ 0U }; y < side; y++) {
+		for (unsigned x{ 0U }; x < side; x++) { values[y * side + x] = PerlinNoise::noise(x * 0.05f, y * 0.05f); }
+	}
+	HeightMap map{ side, side, values };
+	const HeightMap other{ side, side, values };
+	const std::string size{ std::to_string(side) + "x" + std::to_string(side) };
+
+	t_out_results.push_back(measure("heightmap/mean/" + size, S_HEIGHT_MAP_ITERATIONS, [&map](const unsigned long long&) {
+		s_sink = s_sink + static_cast<float>(map.mean());
+	}));
+	t_out_results.push_back(measure("heightmap/standard_deviation/" + size, S_HEIGHT_MAP_ITERATIONS, [&map](const unsigned long long&) {
+		s_sink = s_sink + static_cast<float>(map.standtDev());
+	}));
+	t_out_results.push_back(measure("heightmap/map_to_range/" + size, S_HEIGHT_MAP_ITERATIONS, [&map](const unsigned long long&) {
+		map.mapValuesToRange(-1.0, 1.0);
+	}));
+	t_out_results.push_back(measure("heightmap/clamp/" + size, S_HEIGHT_MAP_ITERATIONS, [&map](const unsigned long long&) {
+		map.clamp(-0.5, 0.5);
+	}));
+	t_out_results.push_back(measure("heightmap/merge/" + size, S_HEIGHT_MAP_ITERATIONS, [&map, &other](const unsigned long long&) {
+		map.merge(other);
+	}));
+	t_out_results.push_back(measure("heightmap/sediment/" + size, S_HEIGHT_MAP_ITERATIONS, [&map, &other](const unsigned long long&) {
+		map.sediment(other);
+	}));
+}
+
+// The lanes of CircleBatch must find exactly what its scalar loop finds. A batch of a single circle never fills a set
+//	of lanes, so every circle is tested on its own too; many of them sit by the edges to exercise the wrapping.
+////////////////////////////////////////////////////////////
+static bool checkCircleBatch() {
+	RandomGenerator rng{ S_SEED };
+	const sf::Vector2f worldSize{ 1000.f, 700.f };
+	CircleBatch batch1, batch2, single1, single2;
+	std::vector<unsigned> hits, singleHits;
+	auto randomCenter{ [&rng, &worldSize]() {
+		const float margin{ rng(0, 1) ? 50.f : worldSize.x }; // Half of them by the top left corner
+		return sf::Vector2f(rng(0.f, std::min(margin, worldSize.x)), rng(0.f, std::min(margin, worldSize.y)));
+	} };
+
+	for (unsigned round{ 0U }; round < S_CIRCLE_CHECK_ROUNDS; round++) {
+		const unsigned size{ round % (S_CIRCLE_CHECK_MAX_SIZE + 1U) };
+		batch1.clear();
+		batch2.clear();
+		for (unsigned i{ 0U }; i < size; i++) {
+			batch1.push(randomCenter(), rng(1.f, 60.f));
+			batch2.push(randomCenter(), rng(1.f, 60.f));
+		}
+		const sf::Vector2f queryCenter{ worldSize.x - randomCenter().x, worldSize.y - randomCenter().y };
+		const float queryRadius{ rng(1.f, 200.f) };
+
+		// One circle against the batch
+		hits.clear();
+		batch1.getOverlaps(hits, queryCenter, queryRadius, worldSize);
+		singleHits.clear();
+		for (unsigned i{ 0U }; i < size; i++) {
+			single1.clear();
+			single1.push(batch1.getCenter(i), batch1.getRadius(i));
+			const std::size_t before{ singleHits.size() };
+			single1.getOverlaps(singleHits, queryCenter, queryRadius, worldSize);
+			if (singleHits.size() > before) { singleHits.back() = i; }
+		}
+		if (hits != singleHits) { return false; }
+
+		// Circle i against circle i
+		hits.clear();
+		CircleBatch::getPairOverlaps(hits, batch1, batch2, worldSize);
+		singleHits.clear();
+		for (unsigned i{ 0U }; i < size; i++) {
+			single1.clear();
+			single2.clear();
+			single1.push(batch1.getCenter(i), batch1.getRadius(i));
+			single2.push(batch2.getCenter(i), batch2.getRadius(i));
+			const std::size_t before{ singleHits.size() };
+			CircleBatch::getPairOverlaps(singleHits, single1, single2, worldSize);
+			if (singleHits.size() > before) { singleHits.back() = i; }
+		}
+		if (hits != singleHits) { return false; }
+	}
+	return true;
+}
+
+// Pairs of actors without a collision callback between them (food with food) must not come out of either broad phase
+////////////////////////////////////////////////////////////
+static bool checkCandidatePairs() {
+	Engine engine{ sf::Vector2u(1080,1080), "Benchmark", true, 0U, S_SEED };
+	CollisionManager& collisions{ engine.getCollisionManager() };
+	CandidatePairs pairs;
+	for (const auto& type : { BroadPhaseType::Grid, BroadPhaseType::Quadtree }) {
+		collisions.setBroadPhaseType(type);
+		collisions.updateBroadPhase();
+		pairs.clear();
+		collisions.getBroadPhase().getCandidatePairs(pairs);
+		const auto numIdle{ std::count_if(pairs.begin(), pairs.end(), [](const CandidatePair& t_pair) {
+			return !CollisionManager::getCollisionFunctor(t_pair.first->getOwner(), t_pair.second->getOwner());
+		}) };
+		std::cout << "> " << (type == BroadPhaseType::Grid ? "Grid" : "Quadtree") << ": " << pairs.size() << " candidate pairs, "
+			<< numIdle << " without a collision callback" << std::endl;
+		if (numIdle != 0) { return false; }
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool runBenchmarkSuite(const std::string& t_fileName) {
+	if (!checkCircleBatch()) {
+		std::cerr << "@ ERROR: runBenchmarkSuite: The batched circle tests disagree with the scalar ones!" << std::endl;
+		return false;
+	}
+	if (!checkCandidatePairs()) {
+		std::cerr << "@ ERROR: runBenchmarkSuite: The broad phase pairs actors that don't interact!" << std::endl;
+		return false;
+	}
+	std::cout << "> Benchmark suite: seed " << S_SEED << (AllocationCounter::isCounting() ? "" : ", allocations not counted") << std::endl;
+	std::vector<BenchmarkResult> results;
+	benchmarkSimulation(results);
+	benchmarkQuadtree(results);
+	benchmarkTraits(results);
+	benchmarkReproduction(results);
+	benchmarkPerlinNoise(results);
+	benchmarkHeightMap(results);
+
+	std::ofstream out{ t_fileName, std::ios::trunc };
+	out << "{\n\t\"version\": " << S_VERSION << ",\n\t\"seed\": " << S_SEED << ",\n\t\"allocations_counted\": "
+		<< (AllocationCounter::isCounting() ? "true" : "false") << ",\n\t\"benchmarks\": [";
+	for (std::size_t i{ 0U }; i < results.size(); i++) {
+		const BenchmarkResult& result{ results[i] };
+		out << (i ? ",\n" : "\n") << "\t\t{ \"name\": \"" << result.m_name << "\", \"iterations\": " << result.m_iterations
+			<< ", \"ns_per_iteration\": " << result.m_nsPerIteration << ", \"allocations_per_iteration\": " << result.m_allocationsPerIteration << " }";
+	}
+	out << "\n\t]\n}\n";
+	if (!out) {
+		std::cerr << "@ ERROR: runBenchmarkSuite: Could not write " << t_fileName << "!" << std::endl;
+		return false;
+	}
+	std::cout << "> Results written to " << t_fileName << std::endl;
+	return true;
+}
@@ -0,0 +1,11 @@
+#ifndef BENCHMARK_SUITE_H
+#define BENCHMARK_SUITE_H
+
+#include <string>
+
+// Runs every benchmark of the simulation core at fixed seeds: headless scenarios of 1k, 10k and 100k actors, then the
+//	quadtree, trait lookups, reproduction, perlin noise and height maps. Prints a table and writes the results as JSON
+//	(time and allocations per iteration of every benchmark) to t_fileName, to be compared across versions.
+bool runBenchmarkSuite(const std::string& t_fileName);
+
+#endif // !BENCHMARK_SUITE_H
@@ -0,0 +1,85 @@
+#include "BroadPhaseBenchmark.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <SFML/System/Clock.hpp>
+#include "CollisionManager.h"
+#include "Collider.h"
+
+static const float S_AREA_PER_ACTOR{ 45000.f }; // 200 actors in 3000 x 3000, like the default scenario
+static const float S_MIN_SIZE{ 8.f };
+static const float S_MAX_SIZE{ 40.f };
+static const float S_MAX_STEP{ 4.f }; // Per tick and axis
+static const unsigned S_SEED{ 42U };
+
+////////////////////////////////////////////////////////////
+static void benchmarkBroadPhase(const BroadPhaseType& t_type, bool t_isIncremental, const std::string& t_name,
+	const unsigned& t_actorCount, const unsigned& t_ticks)
+{
+	const float side{ std::sqrt(t_actorCount * S_AREA_PER_ACTOR) };
+	const sf::FloatRect bounds{ 0.f, 0.f, side, side };
+
+	// Same actors and same walk for every broad phase
+	std::mt19937 rng{ S_SEED };
+	std::uniform_real_distribution<float> position{ 0.f, side };
+	std::uniform_real_distribution<float> size{ S_MIN_SIZE, S_MAX_SIZE };
+	std::uniform_real_distribution<float> step{ -S_MAX_STEP, S_MAX_STEP };
+
+	std::vector<std::unique_ptr<Collider>> colliders;
+	colliders.reserve(t_actorCount);
+	for (unsigned i{ 0U }; i < t_actorCount; i++) {
+		const float s{ size(rng) };
+		colliders.emplace_back(std::make_unique<Collider>(nullptr, sf::Vector2f(position(rng), position(rng)), sf::Vector2f(s, s)));
+	}
+
+	auto broadPhase{ CollisionManager::makeBroadPhase(t_type, bounds) };
+	CandidatePairs pairs;
+	std::size_t totalPairs{ 0U };
+	sf::Clock clock;
+	sf::Time elapsed;
+
+	for (unsigned tick{ 0U }; tick <= t_ticks; tick++) {
+		for (auto& collider : colliders) {
+			auto p{ collider->getCenterPos() };
+			p.x = std::fmod(p.x + step(rng) + side, side);
+			p.y = std::fmod(p.y + step(rng) + side, side);
+			collider->setCenterPos(p);
+		}
+
+		clock.restart();
+		if (t_isIncremental) {
+			for (auto& collider : colliders) { broadPhase->relocate(collider.get()); }
+		}
+		else {
+			broadPhase->clear();
+			for (auto& collider : colliders) { broadPhase->insert(collider.get()); }
+		}
+		broadPhase->update();
+		pairs.clear();
+		broadPhase->getCandidatePairs(pairs);
+
+		// The first tick only fills the structure
+		if (tick > 0U) {
+			elapsed += clock.getElapsedTime();
+			totalPairs += pairs.size();
+		}
+	}
+	broadPhase->clear();
+
+	std::cout << std::left << std::setw(10) << t_actorCount << std::setw(22) << t_name
+		<< std::right << std::setw(12) << std::fixed << std::setprecision(3) << elapsed.asSeconds() * 1000.f / t_ticks << " ms/tick"
+		<< std::setw(14) << totalPairs / t_ticks << " pairs/tick" << std::endl;
+}
+
+////////////////////////////////////////////////////////////
+void runBroadPhaseBenchmark(const std::vector<unsigned>& t_actorCounts, const unsigned& t_ticks) {
+	std::cout << "> Broad phase benchmark: " << t_ticks << " ticks per run" << std::endl;
+	for (const auto& count : t_actorCounts) {
+		benchmarkBroadPhase(BroadPhaseType::Quadtree, true, "quadtree", count, t_ticks);
+		benchmarkBroadPhase(BroadPhaseType::Quadtree, false, "quadtree (rebuilt)", count, t_ticks);
+		benchmarkBroadPhase(BroadPhaseType::Grid, true, "grid", count, t_ticks);
+	}
+}
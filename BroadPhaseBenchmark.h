@@ -0,0 +1,10 @@
+#ifndef BROAD_PHASE_BENCHMARK_H
+#define BROAD_PHASE_BENCHMARK_H
+
+#include <vector>
+
+// Times the broad phases (quadtree incremental and rebuilt, uniform grid) on a toroidal world of randomly
+//	wandering colliders, at the same density as the default scenario, and prints the results to the console.
+void runBroadPhaseBenchmark(const std::vector<unsigned>& t_actorCounts = { 1000U, 10000U, 100000U }, const unsigned& t_ticks = 20U);
+
+#endif // !BROAD_PHASE_BENCHMARK_H
@@ -0,0 +1,92 @@
+#include "BroadPhase_Base.h"
+#include <algorithm>
+#include <cmath>
+#include "Collider.h"
+#include "MathHelpers.h"
+
+////////////////////////////////////////////////////////////
+const int BroadPhase_Base::NO_SLOT{ -1 };
+
+////////////////////////////////////////////////////////////
+void BroadPhase_Base::getPotentialOverlaps(Objects& t_out_objects, const Collider* t_obj)const {
+	getPotentialOverlaps(t_out_objects, t_obj->getAABB());
+}
+
+////////////////////////////////////////////////////////////
+bool BroadPhase_Base::contains(const Collider* t_obj)const { return slot(t_obj) != NO_SLOT; }
+
+////////////////////////////////////////////////////////////
+int& BroadPhase_Base::slot(Collider* t_obj) { return t_obj->m_broadPhaseSlot; }
+
+////////////////////////////////////////////////////////////
+const int& BroadPhase_Base::slot(const Collider* t_obj) { return t_obj->m_broadPhaseSlot; }
+
+////////////////////////////////////////////////////////////
+void BroadPhase_Base::getWithinRange(Objects& t_out_objects, RangeQueryScratch& t_scratch, const sf::Vector2f& t_center, const float& t_range)const {
+	t_scratch.m_candidates.clear();
+	getPotentialOverlaps(t_scratch.m_candidates, { t_center.x - t_range, t_center.y - t_range, t_range * 2.f, t_range * 2.f });
+
+	// Keep only the ones actually in range
+	t_scratch.m_circles.clear();
+	for (const auto& obj : t_scratch.m_candidates) { t_scratch.m_circles.push(obj->getCenterPos(), obj->getRadius()); }
+	t_scratch.m_hits.clear();
+	const auto& bounds{ getBounds() };
+	t_scratch.m_circles.getOverlaps(t_scratch.m_hits, t_center, t_range, { bounds.width, bounds.height });
+	for (const auto& hit : t_scratch.m_hits) { t_out_objects.emplace_back(t_scratch.m_candidates[hit]); }
+}
+
+////////////////////////////////////////////////////////////
+Collider* BroadPhase_Base::getNearest(RangeQueryScratch& t_scratch, const sf::Vector2f& t_center, const float& t_range, const ActorType& t_type)const {
+	t_scratch.m_inRange.clear();
+	getWithinRange(t_scratch.m_inRange, t_scratch, t_center, t_range);
+
+	const auto& bounds{ getBounds() };
+	const sf::Vector2f worldSize{ bounds.width, bounds.height };
+	Collider* nearest{ nullptr };
+	float nearestDistanceSquared{ 0.f };
+	for (auto& obj : t_scratch.m_inRange) {
+		const Actor_Base* owner{ obj->getOwner() };
+		if (!owner || owner->getActorType() != t_type || owner->shouldBeDestroyed()) { continue; }
+		const float distanceSquared{ mat::toroidalDistanceSquared(t_center, obj->getCenterPos(), worldSize) };
+		if (!nearest || distanceSquared < nearestDistanceSquared ||
+			(distanceSquared == nearestDistanceSquared && obj->getOrder() < nearest->getOrder())) { // Ties don't depend on the query order
+			nearest = obj;
+			nearestDistanceSquared = distanceSquared;
+		}
+	}
+	return nearest;
+}
+
+////////////////////////////////////////////////////////////
+unsigned BroadPhase_Base::wrapAABB(sf::FloatRect t_out_pieces[4], const sf::FloatRect& t_aabb, const sf::FloatRect& t_bounds) {
+	// Split each axis into at most two spans inside the bounds; an aabb as big as the bounds covers them all
+	float xs[2][2];
+	float ys[2][2];
+	unsigned numX{ 0U };
+	unsigned numY{ 0U };
+	auto split{ [](float(&t_out_spans)[2][2], unsigned& t_out_count, const float& t_from, const float& t_size, const float& t_min, const float& t_period) {
+		if (t_period <= 0.f) {
+			t_out_spans[0][0] = t_from; t_out_spans[0][1] = t_size; t_out_count = 1U;
+			return;
+		}
+		if (t_size >= t_period) {
+			t_out_spans[0][0] = t_min; t_out_spans[0][1] = t_period; t_out_count = 1U;
+			return;
+		}
+		const float from{ t_min + std::fmod(std::fmod(t_from - t_min, t_period) + t_period, t_period) }; // Wrapped inside [min, min + period)
+		const float to{ from + t_size };
+		const float max{ t_min + t_period };
+		t_out_spans[0][0] = from; t_out_spans[0][1] = std::min(to, max) - from; t_out_count = 1U;
+		if (to > max) { t_out_spans[1][0] = t_min; t_out_spans[1][1] = to - max; t_out_count = 2U; }
+	} };
+	split(xs, numX, t_aabb.left, t_aabb.width, t_bounds.left, t_bounds.width);
+	split(ys, numY, t_aabb.top, t_aabb.height, t_bounds.top, t_bounds.height);
+
+	unsigned numPieces{ 0U };
+	for (unsigned y{ 0U }; y < numY; y++) {
+		for (unsigned x{ 0U }; x < numX; x++) {
+			t_out_pieces[numPieces++] = { xs[x][0], ys[y][0], xs[x][1], ys[y][1] };
+		}
+	}
+	return numPieces;
+}
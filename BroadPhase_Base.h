@@ -0,0 +1,66 @@
+#ifndef BROAD_PHASE_BASE_H
+#define BROAD_PHASE_BASE_H
+
+#include <utility>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "CircleBatch.h"
+
+class Collider;
+enum class ActorType;
+
+using Objects = std::vector<Collider*>;
+using CandidatePair = std::pair<Collider*, Collider*>;
+using CandidatePairs = std::vector<CandidatePair>;
+
+// Reused between range queries, so that they don't allocate
+struct RangeQueryScratch {
+	Objects m_candidates; // From the broad phase, before the exact test
+	CircleBatch m_circles; // Of the candidates
+	std::vector<unsigned> m_hits; // Candidates in range
+	Objects m_inRange; // getNearest()
+};
+
+enum class BroadPhaseType {
+	Quadtree,
+	Grid
+};
+
+// Common interface of the spatial structures that find which colliders may be touching.
+//	Every collider remembers its slot in the structure that holds it, so relocations and removals don't search for it.
+class BroadPhase_Base {
+public:
+	static const int NO_SLOT;
+
+	virtual ~BroadPhase_Base() {}
+	virtual const sf::FloatRect& getBounds()const = 0;
+	virtual void setBounds(const sf::FloatRect& t_bounds) = 0; // Keeps the objects already in
+	virtual void insert(Collider* t_obj) = 0;
+	virtual void remove(Collider* t_obj) = 0;
+	virtual void relocate(Collider* t_obj) = 0; // Inserts the object, or updates it after it moved
+	virtual void clear() = 0;
+	virtual void update() {} // Called once every object is in place, before any query of the tick
+	virtual void getPotentialOverlaps(Objects& t_out_objects, const sf::FloatRect& t_aabb)const = 0; // Wraps around the edges of the bounds
+	virtual void getCandidatePairs(CandidatePairs& t_out_pairs)const = 0; // Every unordered pair at most once
+	virtual void draw(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect) = 0; // Only what is inside the view
+
+	void getPotentialOverlaps(Objects& t_out_objects, const Collider* t_obj)const;
+	bool contains(const Collider* t_obj)const;
+
+	// Colliders whose circle is within t_range of t_center, measured across the edges of the bounds.
+	//	The candidates are tested as a batch of circles against the query circle
+	void getWithinRange(Objects& t_out_objects, RangeQueryScratch& t_scratch, const sf::Vector2f& t_center, const float& t_range)const;
+
+	// Closest collider of the given type within t_range of t_center whose owner isn't about to be destroyed; nullptr if none
+	Collider* getNearest(RangeQueryScratch& t_scratch, const sf::Vector2f& t_center, const float& t_range, const ActorType& t_type)const;
+
+protected:
+	// Cuts an aabb reaching past the bounds into the pieces that wrap back inside them; returns how many pieces (1 to 4)
+	static unsigned wrapAABB(sf::FloatRect t_out_pieces[4], const sf::FloatRect& t_aabb, const sf::FloatRect& t_bounds);
+
+	static int& slot(Collider* t_obj);
+	static const int& slot(const Collider* t_obj);
+};
+
+#endif // !BROAD_PHASE_BASE_H
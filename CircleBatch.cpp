@@ -0,0 +1,156 @@
+#include "CircleBatch.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIRCLE_BATCH_SIMD 1
+
+using Lanes = __m256;
+static const unsigned S_LANES{ 8U };
+
+static inline Lanes load(const float* t_src) { return _mm256_loadu_ps(t_src); }
+static inline Lanes splat(const float& t_value) { return _mm256_set1_ps(t_value); }
+static inline Lanes add(const Lanes& t_a, const Lanes& t_b) { return _mm256_add_ps(t_a, t_b); }
+static inline Lanes sub(const Lanes& t_a, const Lanes& t_b) { return _mm256_sub_ps(t_a, t_b); }
+static inline Lanes mul(const Lanes& t_a, const Lanes& t_b) { return _mm256_mul_ps(t_a, t_b); }
+static inline Lanes select(const Lanes& t_mask, const Lanes& t_a) { return _mm256_and_ps(t_mask, t_a); }
+static inline Lanes greater(const Lanes& t_a, const Lanes& t_b) { return _mm256_cmp_ps(t_a, t_b, _CMP_GT_OQ); }
+static inline Lanes less(const Lanes& t_a, const Lanes& t_b) { return _mm256_cmp_ps(t_a, t_b, _CMP_LT_OQ); }
+static inline unsigned bits(const Lanes& t_mask) { return static_cast<unsigned>(_mm256_movemask_ps(t_mask)); }
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CIRCLE_BATCH_SIMD 1
+
+using Lanes = __m128;
+static const unsigned S_LANES{ 4U };
+
+static inline Lanes load(const float* t_src) { return _mm_loadu_ps(t_src); }
+static inline Lanes splat(const float& t_value) { return _mm_set1_ps(t_value); }
+static inline Lanes add(const Lanes& t_a, const Lanes& t_b) { return _mm_add_ps(t_a, t_b); }
+static inline Lanes sub(const Lanes& t_a, const Lanes& t_b) { return _mm_sub_ps(t_a, t_b); }
+static inline Lanes mul(const Lanes& t_a, const Lanes& t_b) { return _mm_mul_ps(t_a, t_b); }
+static inline Lanes select(const Lanes& t_mask, const Lanes& t_a) { return _mm_and_ps(t_mask, t_a); }
+static inline Lanes greater(const Lanes& t_a, const Lanes& t_b) { return _mm_cmpgt_ps(t_a, t_b); }
+static inline Lanes less(const Lanes& t_a, const Lanes& t_b) { return _mm_cmplt_ps(t_a, t_b); }
+static inline unsigned bits(const Lanes& t_mask) { return static_cast<unsigned>(_mm_movemask_ps(t_mask)); }
+
+#endif
+
+
+// Shortest delta across a toroidal axis, same as mat::toroidalDelta for coordinates inside the world
+////////////////////////////////////////////////////////////
+static inline float wrap(const float& t_delta, const float& t_period, const float& t_halfPeriod) {
+	if (t_delta > t_halfPeriod) { return t_delta - t_period; }
+	if (t_delta < -t_halfPeriod) { return t_delta + t_period; }
+	return t_delta;
+}
+
+////////////////////////////////////////////////////////////
+static inline bool overlaps(const float& t_dx, const float& t_dy, const float& t_radii) {
+	return t_dx * t_dx + t_dy * t_dy < t_radii * t_radii;
+}
+
+#if defined(CIRCLE_BATCH_SIMD)
+////////////////////////////////////////////////////////////
+static inline Lanes wrap(const Lanes& t_delta, const Lanes& t_period, const Lanes& t_halfPeriod, const Lanes& t_minusHalfPeriod) {
+	return add(sub(t_delta, select(greater(t_delta, t_halfPeriod), t_period)), select(less(t_delta, t_minusHalfPeriod), t_period));
+}
+
+////////////////////////////////////////////////////////////
+static inline unsigned overlaps(const Lanes& t_dx, const Lanes& t_dy, const Lanes& t_radii) {
+	return bits(less(add(mul(t_dx, t_dx), mul(t_dy, t_dy)), mul(t_radii, t_radii)));
+}
+
+////////////////////////////////////////////////////////////
+static inline void pushHits(std::vector<unsigned>& t_out_indices, unsigned t_mask, const unsigned& t_first) {
+	for (unsigned lane{ 0U }; t_mask; lane++, t_mask >>= 1U) {
+		if (t_mask & 1U) { t_out_indices.emplace_back(t_first + lane); }
+	}
+}
+#endif // defined(CIRCLE_BATCH_SIMD)
+
+
+////////////////////////////////////////////////////////////
+void CircleBatch::clear() {
+	m_x.clear();
+	m_y.clear();
+	m_radius.clear();
+}
+
+////////////////////////////////////////////////////////////
+void CircleBatch::reserve(const std::size_t& t_size) {
+	m_x.reserve(t_size);
+	m_y.reserve(t_size);
+	m_radius.reserve(t_size);
+}
+
+////////////////////////////////////////////////////////////
+void CircleBatch::push(const sf::Vector2f& t_center, const float& t_radius) {
+	m_x.emplace_back(t_center.x);
+	m_y.emplace_back(t_center.y);
+	m_radius.emplace_back(t_radius);
+}
+
+////////////////////////////////////////////////////////////
+std::size_t CircleBatch::size()const { return m_x.size(); }
+
+////////////////////////////////////////////////////////////
+sf::Vector2f CircleBatch::getCenter(const std::size_t& t_index)const { return { m_x[t_index], m_y[t_index] }; }
+
+////////////////////////////////////////////////////////////
+float CircleBatch::getRadius(const std::size_t& t_index)const { return m_radius[t_index]; }
+
+////////////////////////////////////////////////////////////
+void CircleBatch::getOverlaps(std::vector<unsigned>& t_out_indices, const sf::Vector2f& t_center, const float& t_radius, const sf::Vector2f& t_worldSize)const {
+	const unsigned n{ static_cast<unsigned>(size()) };
+	const sf::Vector2f halfWorld{ t_worldSize * 0.5f };
+	unsigned i{ 0U };
+
+#if defined(CIRCLE_BATCH_SIMD)
+	const Lanes width{ splat(t_worldSize.x) }, height{ splat(t_worldSize.y) };
+	const Lanes halfWidth{ splat(halfWorld.x) }, halfHeight{ splat(halfWorld.y) };
+	const Lanes minusHalfWidth{ splat(-halfWorld.x) }, minusHalfHeight{ splat(-halfWorld.y) };
+	const Lanes cx{ splat(t_center.x) }, cy{ splat(t_center.y) }, radius{ splat(t_radius) };
+
+	for (; i + S_LANES <= n; i += S_LANES) {
+		const Lanes dx{ wrap(sub(load(&m_x[i]), cx), width, halfWidth, minusHalfWidth) };
+		const Lanes dy{ wrap(sub(load(&m_y[i]), cy), height, halfHeight, minusHalfHeight) };
+		const unsigned mask{ overlaps(dx, dy, add(load(&m_radius[i]), radius)) };
+		if (mask) { pushHits(t_out_indices, mask, i); }
+	}
+#endif // defined(CIRCLE_BATCH_SIMD)
+
+	// Whatever doesn't fill a whole set of lanes
+	for (; i < n; i++) {
+		const float dx{ wrap(m_x[i] - t_center.x, t_worldSize.x, halfWorld.x) };
+		const float dy{ wrap(m_y[i] - t_center.y, t_worldSize.y, halfWorld.y) };
+		if (overlaps(dx, dy, m_radius[i] + t_radius)) { t_out_indices.emplace_back(i); }
+	}
+}
+
+////////////////////////////////////////////////////////////
+void CircleBatch::getPairOverlaps(std::vector<unsigned>& t_out_indices, const CircleBatch& t_batch1, const CircleBatch& t_batch2, const sf::Vector2f& t_worldSize) {
+	const unsigned n{ static_cast<unsigned>(t_batch1.size()) };
+	const sf::Vector2f halfWorld{ t_worldSize * 0.5f };
+	unsigned i{ 0U };
+
+#if defined(CIRCLE_BATCH_SIMD)
+	const Lanes width{ splat(t_worldSize.x) }, height{ splat(t_worldSize.y) };
+	const Lanes halfWidth{ splat(halfWorld.x) }, halfHeight{ splat(halfWorld.y) };
+	const Lanes minusHalfWidth{ splat(-halfWorld.x) }, minusHalfHeight{ splat(-halfWorld.y) };
+
+	for (; i + S_LANES <= n; i += S_LANES) {
+		const Lanes dx{ wrap(sub(load(&t_batch2.m_x[i]), load(&t_batch1.m_x[i])), width, halfWidth, minusHalfWidth) };
+		const Lanes dy{ wrap(sub(load(&t_batch2.m_y[i]), load(&t_batch1.m_y[i])), height, halfHeight, minusHalfHeight) };
+		const unsigned mask{ overlaps(dx, dy, add(load(&t_batch1.m_radius[i]), load(&t_batch2.m_radius[i]))) };
+		if (mask) { pushHits(t_out_indices, mask, i); }
+	}
+#endif // defined(CIRCLE_BATCH_SIMD)
+
+	// Whatever doesn't fill a whole set of lanes
+	for (; i < n; i++) {
+		const float dx{ wrap(t_batch2.m_x[i] - t_batch1.m_x[i], t_worldSize.x, halfWorld.x) };
+		const float dy{ wrap(t_batch2.m_y[i] - t_batch1.m_y[i], t_worldSize.y, halfWorld.y) };
+		if (overlaps(dx, dy, t_batch1.m_radius[i] + t_batch2.m_radius[i])) { t_out_indices.emplace_back(i); }
+	}
+}
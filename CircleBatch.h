@@ -0,0 +1,29 @@
+#ifndef CIRCLE_BATCH_H
+#define CIRCLE_BATCH_H
+
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+// Circles packed as a structure of arrays, so that overlap tests run on several of them at a time:
+//	8 lanes with AVX2, 4 with SSE2, one by one otherwise. Distances wrap around a toroidal world of the given size.
+class CircleBatch {
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_radius;
+
+public:
+	void clear();
+	void reserve(const std::size_t& t_size);
+	void push(const sf::Vector2f& t_center, const float& t_radius);
+	std::size_t size()const;
+	sf::Vector2f getCenter(const std::size_t& t_index)const;
+	float getRadius(const std::size_t& t_index)const;
+
+	// Appends the index of every circle of the batch that overlaps the query circle
+	void getOverlaps(std::vector<unsigned>& t_out_indices, const sf::Vector2f& t_center, const float& t_radius, const sf::Vector2f& t_worldSize)const;
+
+	// Appends every index i for which circle i of t_batch1 overlaps circle i of t_batch2; both batches must be the same size
+	static void getPairOverlaps(std::vector<unsigned>& t_out_indices, const CircleBatch& t_batch1, const CircleBatch& t_batch2, const sf::Vector2f& t_worldSize);
+};
+
+#endif // !CIRCLE_BATCH_H
@@ -1,5 +1,6 @@
 #include "Collider.h"
 #include <SFML/Graphics/RectangleShape.hpp>
+#include "BroadPhase_Base.h"
 
 static const sf::Color S_RECT_SHAPE_FILL_COLOR{ 0,255,0,30 };
 static const sf::Color S_RECT_SHAPE_OUTLINE_COLOR{ 0,255,100,200 };
@@ -13,7 +14,8 @@ static const sf::RectangleShape S_RECT_SHAPE{ []() {
 }() };
 
 ////////////////////////////////////////////////////////////
-Collider::Collider(Actor_Base* t_owner, const sf::Vector2f& t_position, const sf::Vector2f& t_size, bool t_isPosCenter) : m_aabb{ sf::FloatRect() }, m_colliderType{ ColliderType::AABB }, m_owner{ t_owner }
+Collider::Collider(Actor_Base* t_owner, const sf::Vector2f& t_position, const sf::Vector2f& t_size, bool t_isPosCenter) : m_aabb{ sf::FloatRect() }, m_colliderType{ ColliderType::AABB }, m_owner{ t_owner }, m_broadPhaseSlot{ BroadPhase_Base::NO_SLOT },
+	m_typeBit{ ~0U }, m_interactionBits{ ~0U }, m_order{ 0U }
 {
 	if (t_isPosCenter) { setCenterPos(t_position); }
 	else { setTopLeftPos(t_position); }
@@ -85,12 +87,30 @@ sf::Vector2f Collider::getCenterPos()const {
 ////////////////////////////////////////////////////////////
 const sf::FloatRect Collider::getAABB()const { return m_aabb; }
 
+////////////////////////////////////////////////////////////
+float Collider::getRadius()const { return m_aabb.width * 0.5f; }
+
 ////////////////////////////////////////////////////////////
 const Actor_Base* Collider::getOwner()const { return m_owner; }
 
 ////////////////////////////////////////////////////////////
 Actor_Base* Collider::getOwner() { return m_owner; }
 
+////////////////////////////////////////////////////////////
+const unsigned& Collider::getOrder()const { return m_order; }
+
+////////////////////////////////////////////////////////////
+void Collider::setOrder(const unsigned& t_order) { m_order = t_order; }
+
+////////////////////////////////////////////////////////////
+void Collider::setInteractions(const unsigned& t_typeBit, const unsigned& t_interactionBits) {
+	m_typeBit = t_typeBit;
+	m_interactionBits = t_interactionBits;
+}
+
+////////////////////////////////////////////////////////////
+bool Collider::canInteract(const Collider* t_other)const { return (m_interactionBits & t_other->m_typeBit) != 0U; }
+
 ////////////////////////////////////////////////////////////
 bool Collider::checkCollision(const Collider* t_otherAABB)const {
 	return m_aabb.intersects(t_otherAABB->m_aabb);
@@ -14,10 +14,16 @@ enum class ColliderType {
 };
 
 class Collider {
+	friend class BroadPhase_Base;
+
 protected:
 	Actor_Base* m_owner;
 	sf::FloatRect m_aabb;
 	ColliderType m_colliderType; // Used to avoid using RTTI on collision resolution
+	int m_broadPhaseSlot; // Where the broad phase holding this collider keeps it; BroadPhase_Base::NO_SLOT when in none
+	unsigned m_typeBit; // Of the owner's actor type
+	unsigned m_interactionBits; // Of the actor types the owner has a collision callback with
+	unsigned m_order; // Rank of the owner among the actors, stamped every tick; keeps results independent of the broad phase's layout
 
 public:
 	Collider( Actor_Base* t_owner,const sf::Vector2f& t_pos, const sf::Vector2f& t_size, bool t_isPosCenter = true);
@@ -35,8 +41,13 @@ public:
 	sf::Vector2f getCenterPos()const;
 	const ColliderType& getColliderType()const;
 	const sf::FloatRect getAABB()const;
+	float getRadius()const; // Of the circle inscribed in the aabb's width
 	const Actor_Base* getOwner()const;
 	Actor_Base* getOwner();
+	const unsigned& getOrder()const;
+	void setOrder(const unsigned& t_order);
+	void setInteractions(const unsigned& t_typeBit, const unsigned& t_interactionBits);
+	bool canInteract(const Collider* t_other)const; // Always true until the interactions are set
 
 	virtual bool checkCollision(const Collider* t_otherAABB)const; // Collision check for two aabbs
 
@@ -1,78 +1,222 @@
 #include "CollisionManager.h"
 #include <algorithm>
+#include <array>
 #include "Engine.h"
 #include "Organism.h"
 #include "Food.h"
 #include "MathHelpers.h"
 #include "Collider.h"
+#include "Quadtree.h"
+#include "SpatialGrid.h"
 
 ////////////////////////////////////////////////////////////
-static CollisionCallback bind(CollisionFunctor t_functor) { return std::bind(t_functor, std::placeholders::_1, std::placeholders::_2); }
+CollisionManager::CollisionManager(Engine* t_owner, const sf::FloatRect& t_rootBounds) :
+	m_broadPhase{ makeBroadPhase(BroadPhaseType::Grid, t_rootBounds) },
+	m_broadPhaseType{ BroadPhaseType::Grid },
+	m_engine{ t_owner },
+	m_isIncremental{ true } {}
 
+////////////////////////////////////////////////////////////
+void CollisionManager::setBounds(const sf::FloatRect& t_bounds) { m_broadPhase->setBounds(t_bounds); }
+
+////////////////////////////////////////////////////////////
+const BroadPhaseType& CollisionManager::getBroadPhaseType()const { return m_broadPhaseType; }
+
+////////////////////////////////////////////////////////////
+void CollisionManager::setBroadPhaseType(const BroadPhaseType& t_type) {
+	if (t_type == m_broadPhaseType) { return; }
+	const sf::FloatRect bounds{ m_broadPhase->getBounds() };
+	m_broadPhase->clear(); // Releases the slots of the colliders
+	m_broadPhase = makeBroadPhase(t_type, bounds);
+	m_broadPhaseType = t_type;
+}
+
+////////////////////////////////////////////////////////////
+const BroadPhase_Base& CollisionManager::getBroadPhase()const { return *m_broadPhase; }
+
+////////////////////////////////////////////////////////////
+std::unique_ptr<BroadPhase_Base> CollisionManager::makeBroadPhase(const BroadPhaseType& t_type, const sf::FloatRect& t_bounds) {
+	switch (t_type) {
+	case BroadPhaseType::Quadtree: return std::make_unique<Quadtree>(t_bounds);
+	case BroadPhaseType::Grid: return std::make_unique<SpatialGrid>(t_bounds);
+	}
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////
+bool CollisionManager::isIncremental()const { return m_isIncremental; }
 
 ////////////////////////////////////////////////////////////
-CollisionManager::CollisionManager(Engine* t_owner, const sf::FloatRect& t_rootBounds) : m_engine{ t_owner }, m_root{ t_rootBounds,0U } {}
+void CollisionManager::setIsIncremental(bool t_isIncremental) { m_isIncremental = t_isIncremental; }
 
 ////////////////////////////////////////////////////////////
-void CollisionManager::setBounds(const sf::FloatRect& t_bounds) { m_root.setBounds(t_bounds); }
+void CollisionManager::remove(Collider* t_obj) { m_broadPhase->remove(t_obj); }
 
 // -------------------------------------------------------- COLLISION PAIRS IMPLEMENTATION	-----------------------------------------
 ////////////////////////////////////////////////////////////
-static void CollisionFn_Organism_Food(Actor_Base* t_o, Actor_Base* t_f) { // The organism eats the food
-	dynamic_cast<Organism*>(t_o)->eat(dynamic_cast<Food*>(t_f));
+static void CollisionFn_Organism_Food(Organism* t_organism, Food* t_food) { // The organism eats the food
+	t_organism->eat(t_food);
+}
+
+
+// -------------------------------------------------------- COLLISION TABLE	-----------------------------------------
+static constexpr std::size_t S_NUM_ACTOR_TYPES{ static_cast<std::size_t>(ActorType::COUNT) };
+using CollisionTable = std::array<std::array<CollisionFunctor, S_NUM_ACTOR_TYPES>, S_NUM_ACTOR_TYPES>;
+
+// The actor type already tells the concrete class, so the casts are static
+////////////////////////////////////////////////////////////
+template<typename T1, typename T2, void(*Fn)(T1*, T2*)>
+static void dispatch(Actor_Base* t_actor1, Actor_Base* t_actor2) { Fn(static_cast<T1*>(t_actor1), static_cast<T2*>(t_actor2)); }
+
+////////////////////////////////////////////////////////////
+template<typename T1, typename T2, void(*Fn)(T1*, T2*)>
+static void dispatchSwapped(Actor_Base* t_actor2, Actor_Base* t_actor1) { Fn(static_cast<T1*>(t_actor1), static_cast<T2*>(t_actor2)); }
+
+////////////////////////////////////////////////////////////
+template<typename T1, typename T2, void(*Fn)(T1*, T2*)>
+static constexpr void registerCollision(CollisionTable& t_table, const ActorType& t_type1, const ActorType& t_type2) {
+	t_table[static_cast<std::size_t>(t_type1)][static_cast<std::size_t>(t_type2)] = &dispatch<T1, T2, Fn>;
+	if (t_type1 != t_type2) { t_table[static_cast<std::size_t>(t_type2)][static_cast<std::size_t>(t_type1)] = &dispatchSwapped<T1, T2, Fn>; }
+}
+
+////////////////////////////////////////////////////////////
+static constexpr CollisionTable makeCollisionTable() {
+	CollisionTable table{};
+	registerCollision<Organism, Food, &CollisionFn_Organism_Food>(table, ActorType::Organism, ActorType::Food);
+	return table;
 }
 
+static constexpr CollisionTable S_COLLISIONS{ makeCollisionTable() };
+
+// Per actor type, a bit for every type it has a callback with; stamped on the colliders so the broad phase
+//	never pairs two actors that don't interact (food with food)
+using InteractionTable = std::array<unsigned, S_NUM_ACTOR_TYPES>;
+
+////////////////////////////////////////////////////////////
+static constexpr InteractionTable makeInteractionTable() {
+	InteractionTable table{};
+	for (std::size_t type1{ 0U }; type1 < S_NUM_ACTOR_TYPES; type1++) {
+		for (std::size_t type2{ 0U }; type2 < S_NUM_ACTOR_TYPES; type2++) {
+			if (S_COLLISIONS[type1][type2] != nullptr) { table[type1] |= 1U << type2; }
+		}
+	}
+	return table;
+}
+
+static constexpr InteractionTable S_INTERACTIONS{ makeInteractionTable() };
+static_assert(S_NUM_ACTOR_TYPES <= sizeof(unsigned) * 8U, "One bit per actor type");
+
 
 ////////////////////////////////////////////////////////////
-const CollisionSolver CollisionManager::s_collisions{
-	{{ActorType::Organism, ActorType::Food}, bind(&CollisionFn_Organism_Food) }
-};
+CollisionFunctor CollisionManager::getCollisionFunctor(const Actor_Base* t_actor1, const Actor_Base* t_actor2) {
+	return S_COLLISIONS[static_cast<std::size_t>(t_actor1->getActorType())][static_cast<std::size_t>(t_actor2->getActorType())];
+}
+
+////////////////////////////////////////////////////////////
+bool CollisionManager::isCollidable(const Actor_Base* t_actor) { return S_INTERACTIONS[static_cast<std::size_t>(t_actor->getActorType())] != 0U; }
+
+////////////////////////////////////////////////////////////
+static void setInteractions(Actor_Base* t_actor) {
+	const std::size_t type{ static_cast<std::size_t>(t_actor->getActorType()) };
+	t_actor->getCollider().setInteractions(1U << type, S_INTERACTIONS[type]);
+}
 
 
 ////////////////////////////////////////////////////////////
-bool CollisionManager::checkCollision(const Collider* t_obj1, const Collider* t_obj2) {
+static std::pair<unsigned, unsigned> getPairOrder(const CandidatePair& t_pair) {
+	const unsigned& order1{ t_pair.first->getOrder() };
+	const unsigned& order2{ t_pair.second->getOrder() };
+	return (order1 < order2 ? std::make_pair(order1, order2) : std::make_pair(order2, order1));
+}
+
+////////////////////////////////////////////////////////////
+bool CollisionManager::checkCollision(const Collider* t_obj1, const Collider* t_obj2)const {
 	// For the sake of simplicity, all colliders are assumed to be circles
 	if (t_obj1->getOwner() == t_obj2->getOwner()) { return false; } // Same object
-	return (mat::distance(t_obj1->getCenterPos(), t_obj2->getCenterPos()) < (t_obj1->getOwner()->getRadius() + t_obj2->getOwner()->getRadius()));
+	const auto& bounds{ m_broadPhase->getBounds() };
+	const float radii{ t_obj1->getRadius() + t_obj2->getRadius() };
+	return (mat::toroidalDistanceSquared(t_obj1->getCenterPos(), t_obj2->getCenterPos(), { bounds.width, bounds.height }) < radii * radii);
 }
 
 
 ////////////////////////////////////////////////////////////
 void CollisionManager::solveCollision(Collider* t_obj1, Collider* t_obj2) {
-	auto it{ s_collisions.find(CollisionPair(t_obj1->getOwner()->getActorType(), t_obj2->getOwner()->getActorType())) };
-	if (it == s_collisions.end()) { return; }
-	it->second(t_obj1->getOwner(), t_obj2->getOwner());
+	const CollisionFunctor functor{ getCollisionFunctor(t_obj1->getOwner(), t_obj2->getOwner()) };
+	if (functor) { functor(t_obj1->getOwner(), t_obj2->getOwner()); }
 }
 
 
 ////////////////////////////////////////////////////////////
-void CollisionManager::update() {
-	m_root.clear(); // Reset quad tree
-
-	// Insert all the actors' colliders in to the machine
-	m_engine->actorsForEach(
-		[this](ActorPtr& t_actor) {	m_root.insert(&t_actor->getCollider());	}
-	);
-
-	Objects objects;
-	m_engine->actorsForEach(
-		[&objects, this](ActorPtr& t_actor) {
-			objects.clear();
-			Collider* obj1{ &t_actor->getCollider() };
-
-			// Get the objects in potential of collision for each single actor
-			m_root.getPotentialOverlaps(objects,obj1);
-
-			for (auto& obj2 : objects) {
-				if (checkCollision(obj1, obj2)) {
-					solveCollision(obj1, obj2);
-				}
+void CollisionManager::updateBroadPhase() {
+	unsigned order{ 0U };
+	m_uncollidables.clear();
+	if (m_isIncremental) {
+		// Only the colliders that moved out of their place (or are new) are touched
+		m_engine->actorsForEach(
+			[this, &order](ActorPtr& t_actor) {
+				t_actor->getCollider().setOrder(order++);
+				if (!isCollidable(t_actor.get())) { m_uncollidables.emplace_back(t_actor.get()); return; }
+				setInteractions(t_actor.get());
+				m_broadPhase->relocate(&t_actor->getCollider());
+			}
+		);
+	}
+	else {
+		m_broadPhase->clear(); // Reset the broad phase, keeping its memory
+
+		// Insert the colliders of the actors that interact with anything in to the machine
+		m_engine->actorsForEach(
+			[this, &order](ActorPtr& t_actor) {
+				t_actor->getCollider().setOrder(order++);
+				if (!isCollidable(t_actor.get())) { m_uncollidables.emplace_back(t_actor.get()); return; }
+				setInteractions(t_actor.get());
+				m_broadPhase->insert(&t_actor->getCollider());
 			}
+		);
+	}
+	m_broadPhase->update();
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<Actor_Base*>& CollisionManager::getUncollidables()const { return m_uncollidables; }
+
+////////////////////////////////////////////////////////////
+void CollisionManager::update() {
+	{
+		PROFILE_SCOPE(m_engine->getProfiler(), ProfilePhase::CollisionBroadPhase);
+		updateBroadPhase();
+	}
+
+	{
+		PROFILE_SCOPE(m_engine->getProfiler(), ProfilePhase::CollisionPairs);
+
+		// Every pair that may be touching comes up once; the broad phase leaves out the pairs of types that don't interact
+		m_candidates.clear();
+		m_broadPhase->getCandidatePairs(m_candidates);
+		m_circles1.clear();
+		m_circles2.clear();
+		for (const auto& pair : m_candidates) {
+			m_circles1.push(pair.first->getCenterPos(), pair.first->getRadius());
+			m_circles2.push(pair.second->getCenterPos(), pair.second->getRadius());
 		}
-	);
+
+		const auto& bounds{ m_broadPhase->getBounds() };
+		m_hits.clear();
+		CircleBatch::getPairOverlaps(m_hits, m_circles1, m_circles2, { bounds.width, bounds.height }); // Test all the circles at once
+	}
+
+	// Solve the hits in actor order: who eats first doesn't depend on how the broad phase happens to store
+	//	its objects (which differs after loading a snapshot, or between broad phases)
+	PROFILE_SCOPE(m_engine->getProfiler(), ProfilePhase::CollisionResolve);
+	std::sort(m_hits.begin(), m_hits.end(), [this](const unsigned& t_lhs, const unsigned& t_rhs) {
+		return getPairOrder(m_candidates[t_lhs]) < getPairOrder(m_candidates[t_rhs]);
+	});
+	for (const auto& hit : m_hits) {
+		solveCollision(m_candidates[hit].first, m_candidates[hit].second);
+	}
 }
 
 ////////////////////////////////////////////////////////////
-void CollisionManager::draw(sf::RenderWindow& t_window) {
-	m_root.draw(t_window);
+void CollisionManager::draw(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect) {
+	m_broadPhase->draw(t_window, t_viewRect);
 }
\ No newline at end of file
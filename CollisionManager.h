@@ -1,39 +1,49 @@
 #ifndef COLLISION_MANAGER_H
 #define COLLISION_MANAGER_H
 
-#include <functional>
-#include <unordered_map>
+#include <memory>
 #include <SFML/Graphics/RenderWindow.hpp>
-#include "Quadtree.h"
-#include "unordered_pair_hash.hpp"
+#include "BroadPhase_Base.h"
+#include "CircleBatch.h"
 
 class Engine;
 class Actor_Base;
-enum class ActorType;
-struct PairHash;
-
-using CollisionFunctor = void(*)(Actor_Base*, Actor_Base*);
-using CollisionCallback = std::function<void(Actor_Base*, Actor_Base*)>; // Every combination of collidable actor types get a collision solving callback
-using CollisionPair = std::pair<ActorType, ActorType>; // Used for its relational operator. Meant to serve as keys in the collision solver hashmap.
-using CollisionSolver = std::unordered_map<CollisionPair, CollisionCallback, std::hash<CollisionPair>, utilities::UnorderedEqual>;
 
+using CollisionFunctor = void(*)(Actor_Base*, Actor_Base*); // Every combination of collidable actor types get a collision solving callback
 
 
 class CollisionManager {
 
-	Quadtree m_root;
+	std::unique_ptr<BroadPhase_Base> m_broadPhase;
+	BroadPhaseType m_broadPhaseType;
+	CandidatePairs m_candidates; // Reused every tick
+	CircleBatch m_circles1; // Circles of the first and second collider of every candidate pair, for the batched overlap test
+	CircleBatch m_circles2;
+	std::vector<unsigned> m_hits; // Candidates whose circles overlap
+	std::vector<Actor_Base*> m_uncollidables; // Actors kept out of the broad phase, in simulation order
 	Engine* m_engine;
+	bool m_isIncremental; // Relocate only the colliders that moved instead of rebuilding the broad phase every tick
 
-	static const CollisionSolver s_collisions;
 	CollisionManager(const CollisionManager& t_rhs) = delete;
 
 public:
 	CollisionManager(Engine* t_owner, const sf::FloatRect& t_rootBounds);
 	void setBounds(const sf::FloatRect& t_bounds);
-	bool checkCollision(const Collider* t_obj1, const Collider* t_obj2);
+	const BroadPhaseType& getBroadPhaseType()const;
+	void setBroadPhaseType(const BroadPhaseType& t_type); // Colliders move over to the new broad phase on the next update
+	const BroadPhase_Base& getBroadPhase()const;
+	static std::unique_ptr<BroadPhase_Base> makeBroadPhase(const BroadPhaseType& t_type, const sf::FloatRect& t_bounds);
+	bool isIncremental()const;
+	void setIsIncremental(bool t_isIncremental);
+	void remove(Collider* t_obj); // Must be called before a collider in the broad phase is destroyed
+	bool checkCollision(const Collider* t_obj1, const Collider* t_obj2)const; // Distances wrap around the edges of the world
 	void solveCollision(Collider* t_obj1, Collider* t_obj2);
+	static CollisionFunctor getCollisionFunctor(const Actor_Base* t_actor1, const Actor_Base* t_actor2); // nullptr if the two types don't interact
+	static bool isCollidable(const Actor_Base* t_actor); // If its type interacts with any other
+	void updateBroadPhase(); // Brings the broad phase up to date with the actors, without solving anything
+	const std::vector<Actor_Base*>& getUncollidables()const; // As of the last update of the broad phase
 	void update();
-	void draw(sf::RenderWindow& t_window);
+	void draw(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect);
 
 };
 
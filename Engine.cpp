@@ -1,3 +1,5 @@
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include "PreprocessorDirectves.h"
 #include "Engine.h"
@@ -5,36 +7,65 @@
 #include "SharedContext.h"
 #include "Scenario_Basic.h"
 #include "Organism.h"
+#include "PerlinNoise.h"
+#include "Profiler.h"
 
 static const sf::Color S_BG_COLOR{ 240,240,240 };
 static const unsigned S_FPS{ 30 };
-static const unsigned S_NUM_FOOD{ 200U };
-static const float S_ENERGY{ 300000 };
-static const unsigned S_NUM_ORGANISMS{ 15U };
-static const float S_SIMULATION_WIDTH{ 3000.f };
-static const float S_SIMULATION_HEIGHT{ 3000.f };
+static const std::size_t S_RESERVED_ORGANISMS{ 4096U }; // Room made up front for organisms alive and pooled, so population booms don't grow the arrays
+static const unsigned S_MAX_SUBSTEPS{ 4U }; // Per unit of simulation speed; past this the simulation slows down instead of spiraling
+static const std::vector<float> S_SIMULATION_SPEEDS{ 1.f, 2.f, 10.f, 0.f }; // 0 = unlimited
+static const float S_CULLING_MARGIN{ 64.f }; // Around the view, for the labels above the sprites and the movement interpolated since the last tick
+static const std::string S_SNAPSHOT_FILE{ "snapshot.bin" }; // Written by the save action
+static const float S_PROFILER_REFRESH{ 0.5f }; // Seconds between two updates of the profiler overlay
+static const unsigned S_PROFILER_TEXT_SIZE{ 14U };
+static const std::string S_GUI_FONT{ "Font_consola" };
+static const unsigned S_LABEL_TEXT_SIZE{ 10U }; // In world units
+static const sf::Color S_LABEL_COLOR{ 25,25,25 };
+static const float S_LABEL_MIN_PIXELS{ 6.f }; // Labels are not drawn when zoomed out so far that their text would be smaller than this
+static const std::uint64_t S_PERLIN_STREAM{ 1U }; // Stream of the run seed used for the perlin permutation table
+static const std::size_t S_ACTORS_PER_JOB{ 64U }; // Grain of the parallel actor update; fixed so results don't depend on the core count
 
 ////////////////////////////////////////////////////////////
-Engine::Engine(const sf::Vector2u& t_windowSize, const std::string& t_windowName) :
+thread_local ActorUpdateBuffer* Engine::s_updateBuffer{ nullptr };
+
+////////////////////////////////////////////////////////////
+Engine::Engine(const sf::Vector2u& t_windowSize, const std::string& t_windowName, bool t_isHeadless, unsigned t_numWorkers, const std::uint64_t& t_seed,
+	const std::string& t_snapshot, const ScenarioSettings& t_scenario) :
+	m_window{},
 	m_windowSize{ t_windowSize },
-	m_keyboard{ Keyboard() },
-	m_eventHandler{ EventHandler() },
 	m_state{ EngineState::Init },
-	m_window{ sf::VideoMode(t_windowSize.x, t_windowSize.y), t_windowName },
-	m_scenario{ nullptr },
-	m_rng{},
-	m_resourceHolder{},
+	m_jobSystem{ t_numWorkers },
+	m_collisionManager{ this, sf::FloatRect() },
 	m_context{},
 	m_maxFramerate{ S_FPS },
-	m_collisionManager{ this, sf::FloatRect() }
+	m_isHeadless{ t_isHeadless },
+	m_tickDuration{ 1.f / S_FPS },
+	m_tickCount{ 0ULL },
+	m_simulationSpeed{ 1.f },
+	m_accumulator{ 0.f },
+	m_interpolation{ 1.f },
+	m_keyboard{ Keyboard() },
+	m_eventHandler{ EventHandler() },
+	m_rng{ t_seed },
+	m_resourceHolder{ t_isHeadless },
+	m_scenarioSettings{ t_scenario },
+	m_scenario{ nullptr },
+	m_snapshotBuffer{ 0U },
+	m_startSnapshot{ t_snapshot },
+	m_isProfilerShown{ false }
 {
 	m_context.m_engine = this;
 	m_context.m_resourceHolder = &m_resourceHolder;
 	m_context.m_rng = &m_rng;
 	m_context.m_window = &m_window;
-	m_window.setFramerateLimit(m_maxFramerate);
+	m_context.m_isHeadless = m_isHeadless;
+	if (!m_isHeadless) {
+		m_window.create(sf::VideoMode(t_windowSize.x, t_windowSize.y), t_windowName);
+		m_window.setFramerateLimit(m_maxFramerate);
+	}
 	init();
-	update(); // Run a single tick to place verything
+	if (!m_tickCount) { update(); } // Run a single tick to place verything; a loaded snapshot already is
 	m_state = EngineState::Paused;
 }
 
@@ -51,67 +82,306 @@ void Engine::init() {
 		m_eventHandler.addAction(std::move(createAction(it.first)));
 	}
 
-	// Add all the keybindings
-	if (!parseBindings("keybindings.txt")) {
+	// Add all the keybindings (there is no input without a window)
+	if (!m_isHeadless && !parseBindings("keybindings.txt")) {
 		std::cout << "Press Enter to exit.\n";
 		std::cin.get();
 		std::exit(1);
 	}
 
-	// Read in all the resources in the dedicated directory
-	m_resourceHolder.init();
+	// Read in all the resources in the dedicated directory; actors take their textures when constructed
+	m_resourceHolder.init(m_jobSystem);
+	waitForResources();
+
+	// Profiler overlay and actor labels
+	Resource* font{ m_resourceHolder.getResource(ResourceType::Font, S_GUI_FONT) };
+	if (font) {
+		m_guiText.setFont(std::get<sf::Font>(*font));
+		m_guiText.setCharacterSize(S_PROFILER_TEXT_SIZE);
+		m_guiText.setFillColor(sf::Color::Black);
+		if (!m_labelRenderer.isInitialized()) { m_labelRenderer.init(std::get<sf::Font>(*font), S_LABEL_TEXT_SIZE, S_LABEL_COLOR); } // Labels keep pointers into its cache
+	}
+
+	// Every random source comes out of the run seed: the perlin table gets its own stream so it doesn't shift the rest
+	PerlinNoise::resetPermutationList(m_rng.getStream(S_PERLIN_STREAM).next());
+
+	// Make room for the population before the first birth
+	m_organismStore.reserve(S_RESERVED_ORGANISMS);
+	m_actors.reserve(S_RESERVED_ORGANISMS + m_scenarioSettings.m_numFood);
+	m_spawnList.reserve(S_RESERVED_ORGANISMS);
 
 	// Initialize simulation scenario
-	m_scenario = std::make_unique<Scenario_Basic>(m_context, S_ENERGY,S_NUM_ORGANISMS, 100U, S_NUM_FOOD, S_NUM_FOOD, S_SIMULATION_WIDTH, S_SIMULATION_HEIGHT);
-	m_scenario->init();
+	const ScenarioSettings& settings{ m_scenarioSettings };
+	m_scenario = std::make_unique<Scenario_Basic>(m_context, settings.m_energy, settings.m_numOrganisms, settings.m_maxNumOrganisms,
+		settings.m_numFood, settings.m_numFood, settings.m_width, settings.m_height);
 
 	// Set the size of the quadtree root
 	m_collisionManager.setBounds(m_scenario->getSimulationRect());
+
+	// Construct the organisms to fill the room made for them, so births don't construct any until the population outgrows it
+	while (m_organismStore.getPoolSize() + m_organismStore.size() < S_RESERVED_ORGANISMS) {
+		m_organismStore.recycle(Organism::makePooled(m_context));
+	}
+
+	// Either resume a saved run or start from the initial population. A snapshot that doesn't load stops the run:
+	//	a fresh world in its place would be saved over it
+	if (m_startSnapshot.empty()) { m_scenario->init(); }
+	else if (!loadSnapshot(m_startSnapshot)) {
+		std::cerr << "@ ERROR: Engine::init: Could not resume from " << m_startSnapshot << "!" << std::endl;
+		std::exit(1);
+	}
 }
 
 ////////////////////////////////////////////////////////////
 void Engine::update() {
-	const float elapsed{ m_elapsed.asSeconds() };
+	const float elapsed{ m_tickDuration };
 	if (m_state == EngineState::Paused) { return; }
 
-	// Spanwn actors from spawn list
-	for (auto actor_it{ m_spawnList.begin() }; actor_it != m_spawnList.end();) {
+	PROFILE_SCOPE(m_profiler, ProfilePhase::Tick);
+	{
+		PROFILE_SCOPE(m_profiler, ProfilePhase::Spawn);
+		spawnPendingActors();
+		for (auto& actor : m_actors) { actor->storePreviousTransform(); }
+	}
+
+	// Bulk organism simulation over the structure of arrays, then the per-actor logic
+	{
+		PROFILE_SCOPE(m_profiler, ProfilePhase::Organisms);
+		m_organismStore.update(elapsed, *m_scenario, m_collisionManager.getBroadPhase()); // Food is sensed where it was at the end of last tick
+	}
+	{
+		PROFILE_SCOPE(m_profiler, ProfilePhase::Actors);
+		updateActors(elapsed);
+	}
+	{
+		PROFILE_SCOPE(m_profiler, ProfilePhase::Scenario);
+		m_scenario->update(elapsed);
+	}
+
+	// Update the collision broad phase and solve the collisions
+	{
+		PROFILE_SCOPE(m_profiler, ProfilePhase::Collision);
+		m_collisionManager.update();
+	}
+
+	m_tickCount++;
+	if (m_telemetry.isOpen()) { m_telemetry.record(m_tickCount, m_organismStore, m_scenario->getEnergy(), Food::getNumFood()); }
+}
+
+
+////////////////////////////////////////////////////////////
+void Engine::spawnPendingActors() {
+	// Single pass over the spawn list: spawned actors are appended to the actors, the rest are compacted
+	//	to the front of the list to try again next tick. Order is preserved on both sides.
+	m_actors.reserve(m_actors.size() + m_spawnList.size());
+	auto keep_it{ m_spawnList.begin() };
+	for (auto& actor : m_spawnList) {
 
 		// Check if the actor is able to spawn given the conditions of the simulation
-		if ((*actor_it)->canSpawn(m_context)) { 
-			// Move them to the spawned actors list
-			m_actors.emplace_back(std::move(*actor_it));
-			actor_it = m_spawnList.erase(actor_it);
-			
+		if (actor->canSpawn(m_context)) {
+			m_actors.emplace_back(std::move(actor));
+
 			// Apply their spawn effect
 			m_actors.back()->onSpawn(m_context);
 		}
-		else { actor_it++; }
+		else {
+			if (&*keep_it != &actor) { *keep_it = std::move(actor); }
+			keep_it++;
+		}
 	}
+	m_spawnList.erase(keep_it, m_spawnList.end());
+}
 
-	// Update actors and delete the wasted ones
-	for (auto it{ m_actors.begin() }; it < m_actors.end();) {
-		auto& actor{ *it->get() };
-		if (actor.shouldBeDestroyed()) {
-			actor.onDestruction(m_context);
-			it = m_actors.erase(it);
+////////////////////////////////////////////////////////////
+void Engine::updateActors(const float& t_elapsed) {
+	// Drop the wasted actors in a single pass; survivors are compacted in order, so removal costs O(1)
+	//	per actor instead of an O(n) erase each. Actors are heap allocated, which keeps every Actor_Base*
+	//	(colliders, callbacks) valid while they are being moved around. Destruction touches shared state,
+	//	so it stays on this thread. Organisms go back to the store's pool, to be reused by the next births.
+	auto keep_it{ m_actors.begin() };
+	for (auto& actor : m_actors) {
+		if (actor->shouldBeDestroyed()) {
+			actor->onDestruction(m_context);
+			m_collisionManager.remove(&actor->getCollider());
+			if (actor->getActorType() == ActorType::Organism) { m_organismStore.recycle(OrganismPtr{ static_cast<Organism*>(actor.release()) }); }
+			else { actor.reset(); }
+			continue;
 		}
-		else {
-			actor.update(elapsed);
-			it++;
+
+		if (&*keep_it != &actor) { *keep_it = std::move(actor); }
+		keep_it++;
+	}
+	m_actors.erase(keep_it, m_actors.end());
+
+	// Update the survivors in parallel; every actor only writes its own state, anything shared goes to its chunk's buffer
+	m_updateBuffers.resize(JobSystem::getNumChunks(m_actors.size(), S_ACTORS_PER_JOB));
+	m_jobSystem.parallelFor(m_actors.size(), S_ACTORS_PER_JOB,
+		[this, &t_elapsed](const std::size_t& t_begin, const std::size_t& t_end, const std::size_t& t_chunk) {
+			s_updateBuffer = &m_updateBuffers[t_chunk];
+			for (std::size_t i{ t_begin }; i < t_end; i++) { m_actors[i]->update(t_elapsed); }
+			s_updateBuffer = nullptr;
+		});
+
+	applyUpdateBuffers();
+}
+
+////////////////////////////////////////////////////////////
+void Engine::applyUpdateBuffers() {
+	// Chunk order is actor order, so the outcome is the same no matter which thread ran which chunk
+	for (auto& buffer : m_updateBuffers) {
+		if (buffer.m_energy != 0.f) { m_scenario->addEnergy(buffer.m_energy); }
+		for (auto& actor : buffer.m_spawns) { m_spawnList.emplace_back(std::move(actor)); }
+		for (auto& job : buffer.m_deferred) { job(); }
+
+		buffer.m_energy = 0.f;
+		buffer.m_spawns.clear();
+		buffer.m_deferred.clear();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Engine::saveSnapshot(const std::string& t_fileName) {
+	// Copying the world is a handful of memcpys plus one record per actor; the disk is left to another thread
+	Snapshot& snapshot{ m_snapshots[m_snapshotBuffer] };
+	captureSnapshot(snapshot);
+	waitForSnapshotWrite(); // One write at a time; the last one used the other buffer
+	m_snapshotWrite = std::async(std::launch::async, [&snapshot, t_fileName]() {
+		const bool isWritten{ snapshot.writeToFile(t_fileName) };
+		if (!isWritten) { std::cerr << "@ ERROR: Engine::saveSnapshot: Could not write " << t_fileName << "!" << std::endl; }
+		return isWritten;
+	});
+	m_snapshotBuffer = 1U - m_snapshotBuffer;
+}
+
+////////////////////////////////////////////////////////////
+bool Engine::waitForSnapshotWrite() { return m_snapshotWrite.valid() ? m_snapshotWrite.get() : true; }
+
+////////////////////////////////////////////////////////////
+bool Engine::openTelemetry(const std::string& t_fileName, const unsigned& t_sampleInterval) { return m_telemetry.open(t_fileName, t_sampleInterval); }
+
+////////////////////////////////////////////////////////////
+Profiler& Engine::getProfiler() { return m_profiler; }
+
+////////////////////////////////////////////////////////////
+bool Engine::writeProfile(const std::string& t_fileName)const {
+	std::ofstream out{ t_fileName, std::ios::trunc };
+	m_profiler.dump(out);
+	if (!out) { std::cerr << "@ ERROR: Engine::writeProfile: Could not write " << t_fileName << "!" << std::endl; }
+	return static_cast<bool>(out);
+}
+
+////////////////////////////////////////////////////////////
+void Engine::captureSnapshot(Snapshot& t_out_snapshot)const {
+	t_out_snapshot.clear();
+	t_out_snapshot.m_tickCount = m_tickCount;
+	t_out_snapshot.m_seed = m_rng.getSeed();
+	t_out_snapshot.m_rngCounter = m_rng.getCounter();
+	std::copy_n(PerlinNoise::getPermutationList(), t_out_snapshot.m_perlinPermutations.size(), t_out_snapshot.m_perlinPermutations.begin());
+	t_out_snapshot.m_energyPool = m_scenario->getEnergy();
+	t_out_snapshot.m_numFood = Food::getNumFood();
+
+	t_out_snapshot.m_columns = m_organismStore.getColumns(); // Reuses the memory of the last capture into this buffer
+	t_out_snapshot.m_flags = m_organismStore.getFlags();
+	t_out_snapshot.m_rowOwners.assign(m_organismStore.size(), Snapshot::s_noOwner);
+
+	auto capture{ [&t_out_snapshot](const Actors& t_actors, std::vector<ActorRef>& t_out_refs) {
+		for (const auto& actor : t_actors) {
+			if (actor->getActorType() == ActorType::Organism) {
+				const std::uint32_t index{ static_cast<std::uint32_t>(t_out_snapshot.m_organisms.size()) };
+				t_out_snapshot.m_organisms.emplace_back();
+				t_out_snapshot.m_genomes.emplace_back();
+				static_cast<const Organism&>(*actor).writeSnapshot(t_out_snapshot.m_organisms.back(), t_out_snapshot.m_genomes.back(), t_out_snapshot.m_names);
+				t_out_snapshot.m_rowOwners[t_out_snapshot.m_organisms.back().m_slot] = index;
+				t_out_refs.push_back({ ActorType::Organism, index });
+			}
+			else if (actor->getActorType() == ActorType::Food) {
+				const std::uint32_t index{ static_cast<std::uint32_t>(t_out_snapshot.m_food.size()) };
+				t_out_snapshot.m_food.emplace_back();
+				static_cast<const Food&>(*actor).writeSnapshot(t_out_snapshot.m_food.back());
+				t_out_refs.push_back({ ActorType::Food, index });
+			}
+		}
+	} };
+	capture(m_actors, t_out_snapshot.m_actors);
+	capture(m_spawnList, t_out_snapshot.m_spawnList);
+}
+
+////////////////////////////////////////////////////////////
+bool Engine::loadSnapshot(const std::string& t_fileName) {
+	waitForSnapshotWrite();
+	SnapshotView snapshot; // Mapped only while loading: the store copies its columns, the actors their records
+	if (!snapshot.open(t_fileName)) {
+		std::cerr << "@ ERROR: Engine::loadSnapshot: " << t_fileName << " is missing, corrupted or not a snapshot of this version!" << std::endl;
+		return false;
+	}
+	clearActors();
+
+	// Actors are placed as they were, without their spawn effects: the energy they hold is already out of the pool
+	const std::vector<Organism*> templates{ m_organismStore.getOwners() }; // Organisms that aren't part of the world
+	const auto records{ snapshot.getOrganisms() };
+	const auto genomes{ snapshot.getGenomes() };
+	const auto food{ snapshot.getFood() };
+	std::vector<Organism*> organisms(records.size(), nullptr);
+	m_actors.reserve(snapshot.getActors().size());
+	auto place{ [&](const SnapshotTable<ActorRef>& t_refs, Actors& t_out_actors) {
+		for (const auto& ref : t_refs) {
+			if (ref.m_type == ActorType::Organism) {
+				const OrganismSnapshot& record{ records[ref.m_index] };
+				auto organism{ Organism::makeFromSnapshot(m_context, record, genomes[ref.m_index], snapshot.getName(record)) };
+				organisms[ref.m_index] = organism.get();
+				t_out_actors.emplace_back(std::move(organism));
+			}
+			else { t_out_actors.emplace_back(Food::makeFromSnapshot(m_context, food[ref.m_index])); }
 		}
+	} };
+	place(snapshot.getActors(), m_actors);
+	place(snapshot.getSpawnList(), m_spawnList);
+
+	// Put every organism back in its row of the store; the templates take the rows that weren't saved, in order
+	std::vector<Organism*> owners;
+	owners.reserve(snapshot.getRowOwners().size());
+	auto template_it{ templates.cbegin() };
+	for (const auto& owner : snapshot.getRowOwners()) {
+		if (owner != Snapshot::s_noOwner) { owners.push_back(organisms[owner]); }
+		else { owners.push_back(template_it != templates.cend() ? *template_it++ : nullptr); }
+	}
+	OrganismColumnData columns;
+	for (std::size_t i{ 0U }; i < columns.size(); i++) { columns[i] = snapshot.getColumn(static_cast<OrganismField>(i)); }
+	if (std::find(owners.cbegin(), owners.cend(), nullptr) != owners.cend() ||
+		!m_organismStore.restore(columns, snapshot.getFlags().data(), owners))
+	{
+		std::cerr << "@ ERROR: Engine::loadSnapshot: The organisms of " << t_fileName << " don't match its store!" << std::endl;
+		clearActors();
+		return false;
 	}
 
-	m_scenario->update(elapsed);
+	const SnapshotHeader& header{ snapshot.getHeader() };
+	PerlinNoise::setPermutationList(header.m_perlinPermutations.data());
+	m_scenario->setEnergy(header.m_energyPool);
+	Food::setNumFood(header.m_numFood);
+	m_rng = RandomGenerator(header.m_seed);
+	m_rng.setCounter(header.m_rngCounter);
+	m_tickCount = header.m_tickCount;
+	m_collisionManager.updateBroadPhase(); // The next tick senses food before the collisions update it
 
-	// Build the collision quadtree
-	m_collisionManager.update();
+	std::cout << "> Loaded " << t_fileName << ": tick " << m_tickCount << ", " << m_actors.size() << " actors" << std::endl;
+	return true;
 }
 
+////////////////////////////////////////////////////////////
+void Engine::clearActors() {
+	for (auto& actor : m_actors) { m_collisionManager.remove(&actor->getCollider()); }
+	m_actors.clear();
+	m_spawnList.clear();
+	m_collisionManager.updateBroadPhase(); // Forgets the actors it kept aside
+}
 
 ////////////////////////////////////////////////////////////
 const EngineState& Engine::getState()const { return m_state; }
 
+////////////////////////////////////////////////////////////
+void Engine::setState(const EngineState& t_state) { m_state = t_state; }
+
 
 ////////////////////////////////////////////////////////////
 bool Engine::executeAction(const ActionId& t_id, const EventInfo& t_info) {
@@ -121,25 +391,111 @@ bool Engine::executeAction(const ActionId& t_id, const EventInfo& t_info) {
 ////////////////////////////////////////////////////////////
 sf::Time Engine::getElapsed()const { return m_elapsed; }
 
+////////////////////////////////////////////////////////////
+bool Engine::isHeadless()const { return m_isHeadless; }
+
+////////////////////////////////////////////////////////////
+float Engine::getTickDuration()const { return m_tickDuration; }
+
+////////////////////////////////////////////////////////////
+void Engine::setTickDuration(const float& t_seconds) { m_tickDuration = t_seconds; }
+
+////////////////////////////////////////////////////////////
+const unsigned long long& Engine::getTickCount()const { return m_tickCount; }
+
+////////////////////////////////////////////////////////////
+const std::uint64_t& Engine::getSeed()const { return m_rng.getSeed(); }
+
+////////////////////////////////////////////////////////////
+float Engine::getSimulationSpeed()const { return m_simulationSpeed; }
+
+////////////////////////////////////////////////////////////
+void Engine::setSimulationSpeed(const float& t_speed) {
+	m_simulationSpeed = (t_speed > 0.f ? t_speed : 0.f);
+	m_accumulator = 0.f;
+}
+
 ////////////////////////////////////////////////////////////
 const sf::FloatRect& Engine::getSimulationRect()const { return m_scenario->getSimulationRect(); }
 
 ////////////////////////////////////////////////////////////
 void Engine::run() {
+	std::cout << "> Seed: " << getSeed() << std::endl; // Pass it back with --seed to replay the run
 
 	// Window loop
 	while (m_window.isOpen()) {
 
-		// Restar the clock and capture elapsed time
+		// Restar the clock and capture elapsed time (the view keeps moving in real time)
 		m_elapsed = m_clock.restart();
+		PROFILE_SCOPE(m_profiler, ProfilePhase::Frame);
 		pollEvents();
-		update();
+		advanceSimulation();
 		render();
 	}
 }
 
+////////////////////////////////////////////////////////////
+void Engine::advanceSimulation() {
+	if (m_state != EngineState::Running) {
+		m_interpolation = 1.f;
+		return;
+	}
+
+	// Unlimited speed: fill the frame with as many ticks as fit in it
+	if (m_simulationSpeed <= 0.f) {
+		sf::Clock frameClock;
+		const float frameBudget{ 1.f / m_maxFramerate };
+		do { update(); } while (frameClock.getElapsedTime().asSeconds() < frameBudget);
+		m_accumulator = 0.f;
+		m_interpolation = 1.f;
+		return;
+	}
+
+	m_accumulator += m_elapsed.asSeconds() * m_simulationSpeed;
+
+	const unsigned maxSubsteps{ static_cast<unsigned>(std::ceil(m_simulationSpeed)) * S_MAX_SUBSTEPS };
+	unsigned substeps{ 0U };
+	while (m_accumulator >= m_tickDuration && substeps < maxSubsteps) {
+		update();
+		m_accumulator -= m_tickDuration;
+		substeps++;
+	}
+
+	// Couldn't keep up; drop the backlog rather than carrying it into the next frame
+	if (m_accumulator >= m_tickDuration) { m_accumulator = std::fmod(m_accumulator, m_tickDuration); }
+
+	m_interpolation = m_accumulator / m_tickDuration;
+}
+
+////////////////////////////////////////////////////////////
+void Engine::runHeadless(const unsigned long long& t_maxTicks, const float& t_maxSimulatedTime) {
+	if (!t_maxTicks && t_maxSimulatedTime <= 0.f) {
+		std::cerr << "@ ERROR: Engine::runHeadless: Either a tick count or a simulated time budget is required." << std::endl;
+		return;
+	}
+
+	m_state = EngineState::Running;
+	std::cout << "> Seed: " << getSeed() << std::endl;
+
+	unsigned long long ticks{ 0ULL };
+	double simulatedTime{ 0.0 }; // Worked out from the tick count, so it doesn't drift over long runs
+	sf::Clock wallClock;
+
+	while ((!t_maxTicks || ticks < t_maxTicks) && (t_maxSimulatedTime <= 0.f || simulatedTime < t_maxSimulatedTime)) {
+		update();
+		ticks++;
+		simulatedTime = static_cast<double>(ticks) * m_tickDuration;
+	}
+
+	float wallTime{ wallClock.getElapsedTime().asSeconds() };
+	std::cout << "> Headless run: " << ticks << " ticks (" << simulatedTime << " s simulated) in " << wallTime << " s ("
+		<< (wallTime > 0.f ? static_cast<float>(ticks) / wallTime : 0.f) << " ticks/s), " << m_actors.size() << " actors alive" << std::endl;
+	std::cout << "> Population checksum: " << std::hex << m_organismStore.getChecksum() << std::dec << std::endl; // Same seed and ticks, same checksum
+}
+
 ////////////////////////////////////////////////////////////
 void Engine::pollEvents() {
+	PROFILE_SCOPE(m_profiler, ProfilePhase::Events);
 
 	m_keyboard.reset();
 	const auto& pressedKeys{ m_keyboard.getPressedKeys() };
@@ -172,6 +528,21 @@ void Engine::pollEvents() {
 
 }
 
+////////////////////////////////////////////////////////////
+void Engine::waitForResources() {
+	// Only closing is handled: the actions expect a scenario, which needs the textures first
+	while (!m_isHeadless && m_window.isOpen() && m_resourceHolder.isLoading()) {
+		sf::Event e;
+		while (m_window.pollEvent(e)) {
+			if (e.type == sf::Event::Closed) { m_window.close(); }
+		}
+		m_resourceHolder.processLoaded(); // Textures decoded so far go to the gpu
+		m_window.clear(S_BG_COLOR);
+		m_window.display();
+	}
+	m_resourceHolder.waitForLoading();
+}
+
 ////////////////////////////////////////////////////////////
 float Engine::getRandom(const float& t_min, const float& t_max) { return m_rng(t_min, t_max); }
 
@@ -186,6 +557,7 @@ sf::RenderWindow& Engine::getWindow() {
 
 ////////////////////////////////////////////////////////////
 void Engine::render() {
+	PROFILE_SCOPE(m_profiler, ProfilePhase::Render);
 
 	// Apply the engine view to the window
 	m_window.setView(m_view);
@@ -196,16 +568,55 @@ void Engine::render() {
 	// Draw any scenery placed by the scenario
 	m_scenario->draw();
 
-#if defined(_DEBUG) && IS_DRAW_COLLISION_QUADTREE == 1
-	m_collisionManager.draw(m_window); // Draw the collision quadtree (debug)
-#endif // defined(_DEBUG) && IS_DRAW_COLLISION_QUADTREE == 1
-	// Draw the actors
-	for (auto& actor : m_actors) {
-		actor->draw();
+	const sf::Vector2f viewSize{ m_view.getSize() + sf::Vector2f(S_CULLING_MARGIN, S_CULLING_MARGIN) * 2.f };
+	const sf::FloatRect viewRect{ m_view.getCenter() - viewSize * 0.5f, viewSize };
+#if defined(_DEBUG) && IS_DRAW_COLLISION_BROAD_PHASE == 1
+	m_collisionManager.draw(m_window, viewRect); // Draw the collision broad phase (debug)
+#endif // defined(_DEBUG) && IS_DRAW_COLLISION_BROAD_PHASE == 1
+	// Only the actors in view are placed and drawn. The broad phase was brought up to date with the actors at the end of
+	//	the last tick, so it finds the ones that collide with anything; the others are kept aside and tested one by one.
+	m_visibleColliders.clear();
+	m_collisionManager.getBroadPhase().getPotentialOverlaps(m_visibleColliders, viewRect);
+	m_visibleActors.clear();
+	for (auto& collider : m_visibleColliders) { m_visibleActors.emplace_back(collider->getOwner()); }
+	for (auto& actor : m_collisionManager.getUncollidables()) {
+		if (actor->getCollider().getAABB().intersects(viewRect)) { m_visibleActors.emplace_back(actor); }
+	}
+	std::sort(m_visibleActors.begin(), m_visibleActors.end(), // Back in simulation order, so overlapping sprites stack the same every frame
+		[](const Actor_Base* t_1, const Actor_Base* t_2) { return t_1->getCollider().getOrder() < t_2->getCollider().getOrder(); });
+	m_visibleActors.erase(std::unique(m_visibleActors.begin(), m_visibleActors.end()), m_visibleActors.end()); // Views wider than the world find some twice
+
+	// Draw the actors: every sprite in one batch, then the labels over them
+	m_spriteBatch.clear();
+	for (auto& actor : m_visibleActors) {
+		actor->interpolateTransform(m_interpolation);
+		actor->draw(m_spriteBatch);
+	}
+	m_window.draw(m_spriteBatch);
+
+	// Labels only once they are big enough on screen to be read
+	m_labelRenderer.clear();
+	const float pixelsPerUnit{ m_window.getSize().y / m_view.getSize().y };
+	if (S_LABEL_TEXT_SIZE * pixelsPerUnit >= S_LABEL_MIN_PIXELS) {
+		for (auto& actor : m_visibleActors) { actor->drawLabel(m_labelRenderer); }
+		m_window.draw(m_labelRenderer);
+	}
 #if defined(_DEBUG) && IS_DRAW_ACTOR_AABB == 1
-		actor->getCollider().draw(m_window);
+	for (auto& actor : m_visibleActors) { actor->getCollider().draw(m_window); }
 #endif // defined(_DEBUG) && IS_DRAW_ACTOR_AABB == 1
+
+#if IS_PROFILE_FRAMES == 1
+	if (m_isProfilerShown) {
+		if (m_profilerRefresh.getElapsedTime().asSeconds() >= S_PROFILER_REFRESH) {
+			m_guiText.setString(m_profiler.getOverlayText() + std::to_string(m_spriteBatch.getNumSprites()) + " sprites in "
+				+ std::to_string(m_spriteBatch.getNumDrawCalls()) + " draw calls");
+			m_profilerRefresh.restart();
+		}
+		m_window.setView(m_window.getDefaultView()); // Screen space
+		m_window.draw(m_guiText);
+		m_window.setView(m_view);
 	}
+#endif // IS_PROFILE_FRAMES == 1
 
 	m_window.display();
 }
@@ -271,13 +682,14 @@ unsigned Engine::getMaxFramerate()const { return m_maxFramerate; }
 ////////////////////////////////////////////////////////////
 void Engine::setMaxFramerate(const unsigned& t_fps) {
 	m_maxFramerate = t_fps;
+	if (m_isHeadless) { return; }
 	m_window.setFramerateLimit(m_maxFramerate);
 }
 
 ////////////////////////////////////////////////////////////
 void Engine::resetView() {
 	m_view = sf::View();
-	m_view.setCenter(static_cast<float>(S_SIMULATION_WIDTH) * 0.5f, static_cast<float>(S_SIMULATION_HEIGHT) * 0.5f);
+	m_view.setCenter(m_scenarioSettings.m_width * 0.5f, m_scenarioSettings.m_height * 0.5f);
 }
 
 ////////////////////////////////////////////////////////////
@@ -286,10 +698,32 @@ const Scenario_Basic& Engine::getScenario() const { return *m_scenario.get(); }
 ////////////////////////////////////////////////////////////
 Scenario_Basic& Engine::getScenario() { return *m_scenario.get(); }
 
+////////////////////////////////////////////////////////////
+OrganismStore& Engine::getOrganismStore() { return m_organismStore; }
+
+////////////////////////////////////////////////////////////
+CollisionManager& Engine::getCollisionManager() { return m_collisionManager; }
+
+////////////////////////////////////////////////////////////
+SharedContext& Engine::getContext() { return m_context; }
+
 ////////////////////////////////////////////////////////////
 void Engine::spawnActor(ActorPtr t_actor) { 
+	if (s_updateBuffer) { s_updateBuffer->m_spawns.emplace_back(std::move(t_actor)); return; }
 	m_spawnList.emplace_back(std::move(t_actor)); }
 
+////////////////////////////////////////////////////////////
+void Engine::defer(Job t_job) {
+	if (s_updateBuffer) { s_updateBuffer->m_deferred.emplace_back(std::move(t_job)); return; }
+	t_job();
+}
+
+////////////////////////////////////////////////////////////
+ActorUpdateBuffer* Engine::getUpdateBuffer() { return s_updateBuffer; }
+
+////////////////////////////////////////////////////////////
+unsigned Engine::getNumWorkers()const { return m_jobSystem.getNumWorkers(); }
+
 
 static const std::string S_EMPTY_STR{ "" };
 
@@ -334,7 +768,13 @@ const ActionFactory Engine::s_actions{
 		{ActionId::ZoomOut,					{"Action_ZoomOut",				EngineState::Running,	ActionTrigger::ContinousKeyPress,	&Engine::Action_ZoomOut}},
 		{ActionId::ZoomOut_Paused,			{"Action_ZoomOut_Paused",		EngineState::Paused,	ActionTrigger::ContinousKeyPress,	&Engine::Action_ZoomOut_Paused}},
 		{ActionId::ResetZoom,				{"Action_ResetZoom",			EngineState::Running,	ActionTrigger::SingleKeyRelease,	&Engine::Action_ResetZoom}},
-		{ActionId::ResetZoom_Paused,		{"Action_ResetZoom_Paused",		EngineState::Paused,	ActionTrigger::SingleKeyRelease,	&Engine::Action_ResetZoom_Paused}}
+		{ActionId::ResetZoom_Paused,		{"Action_ResetZoom_Paused",		EngineState::Paused,	ActionTrigger::SingleKeyRelease,	&Engine::Action_ResetZoom_Paused}},
+		{ActionId::SpeedUp,					{"Action_SpeedUp",				EngineState::Running,	ActionTrigger::SingleKeyRelease,	&Engine::Action_SpeedUp}},
+		{ActionId::SpeedUp_Paused,			{"Action_SpeedUp_Paused",		EngineState::Paused,	ActionTrigger::SingleKeyRelease,	&Engine::Action_SpeedUp_Paused}},
+		{ActionId::SpeedDown,				{"Action_SpeedDown",			EngineState::Running,	ActionTrigger::SingleKeyRelease,	&Engine::Action_SpeedDown}},
+		{ActionId::SpeedDown_Paused,		{"Action_SpeedDown_Paused",		EngineState::Paused,	ActionTrigger::SingleKeyRelease,	&Engine::Action_SpeedDown_Paused}},
+		{ActionId::ToggleProfiler,			{"Action_ToggleProfiler",		EngineState::Running,	ActionTrigger::SingleKeyRelease,	&Engine::Action_ToggleProfiler}},
+		{ActionId::ToggleProfiler_Paused,	{"Action_ToggleProfiler_Paused",EngineState::Paused,	ActionTrigger::SingleKeyRelease,	&Engine::Action_ToggleProfiler_Paused}}
 };
 
 ////////////////////////////////////////////////////////////
@@ -528,8 +968,71 @@ void Engine::Action_ResetZoom_Paused(const EventInfo& t_info) {
 #endif
 }
 
+////////////////////////////////////////////////////////////
+static float nextSimulationSpeed(const float& t_speed, bool t_isFaster) {
+	auto it{ std::find(S_SIMULATION_SPEEDS.cbegin(), S_SIMULATION_SPEEDS.cend(), t_speed) };
+	if (it == S_SIMULATION_SPEEDS.cend()) { return S_SIMULATION_SPEEDS.front(); }
+	if (t_isFaster) { return (it + 1 == S_SIMULATION_SPEEDS.cend() ? *it : *(it + 1)); }
+	return (it == S_SIMULATION_SPEEDS.cbegin() ? *it : *(it - 1));
+}
+
+////////////////////////////////////////////////////////////
+void Engine::Action_SpeedUp(const EventInfo& t_info) {
+	setSimulationSpeed(nextSimulationSpeed(m_simulationSpeed, true));
+
+#if defined(_DEBUG) && IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE == 1
+	std::cout << "> ACTION\tSpeedUp" << std::endl;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+void Engine::Action_SpeedUp_Paused(const EventInfo& t_info) {
+	setSimulationSpeed(nextSimulationSpeed(m_simulationSpeed, true));
+
+#if defined(_DEBUG) && IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE == 1
+	std::cout << "> ACTION\tSpeedUp_Paused" << std::endl;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+void Engine::Action_SpeedDown(const EventInfo& t_info) {
+	setSimulationSpeed(nextSimulationSpeed(m_simulationSpeed, false));
+
+#if defined(_DEBUG) && IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE == 1
+	std::cout << "> ACTION\tSpeedDown" << std::endl;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+void Engine::Action_SpeedDown_Paused(const EventInfo& t_info) {
+	setSimulationSpeed(nextSimulationSpeed(m_simulationSpeed, false));
+
+#if defined(_DEBUG) && IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE == 1
+	std::cout << "> ACTION\tSpeedDown_Paused" << std::endl;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+void Engine::Action_ToggleProfiler(const EventInfo& t_info) {
+	m_isProfilerShown = !m_isProfilerShown;
+
+#if defined(_DEBUG) && IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE == 1
+	std::cout << "> ACTION\tToggleProfiler" << std::endl;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+void Engine::Action_ToggleProfiler_Paused(const EventInfo& t_info) {
+	m_isProfilerShown = !m_isProfilerShown;
+
+#if defined(_DEBUG) && IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE == 1
+	std::cout << "> ACTION\tToggleProfiler_Paused" << std::endl;
+#endif
+}
+
 ////////////////////////////////////////////////////////////
 void Engine::Action_Save(const EventInfo& t_info) {
+	saveSnapshot(S_SNAPSHOT_FILE);
 
 #if defined(_DEBUG) && IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE == 1
 	std::cout << "> ACTION\tSave" << std::endl;
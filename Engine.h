@@ -2,9 +2,12 @@
 #define	 ENGINE_H
 
 #include <algorithm>
+#include <array>
+#include <future>
 #include <memory>
 #include <string>
 #include <functional>
+#include <map>
 #include <unordered_map>
 #include <vector>
 #include <SFML/Graphics.hpp>
@@ -17,12 +20,26 @@
 #include "Actor_Base.h"
 #include "Scenario_Basic.h"
 #include "CollisionManager.h"
+#include "OrganismStore.h"
+#include "JobSystem.h"
+#include "Snapshot.h"
+#include "TelemetryWriter.h"
+#include "Profiler.h"
+#include "SpriteBatch.h"
+#include "LabelRenderer.h"
 
 using ActorPtr = std::unique_ptr<Actor_Base>;
 using Actors = std::vector<ActorPtr>; // contains all the actors in the current simulation
 using StateNames = std::map<std::string, EngineState>;
 struct EventInfo;
 
+// Side effects of the actors on shared state, recorded while they are updated in parallel and applied afterwards in chunk order
+struct ActorUpdateBuffer {
+	float m_energy{ 0.f }; // Net energy returned to the scenario
+	Actors m_spawns;
+	std::vector<Job> m_deferred; // Work that has to run on the main thread (e.g. constructing offspring)
+};
+
 
 
 class Engine {
@@ -30,13 +47,20 @@ private:
 	sf::RenderWindow m_window;
 	sf::Text m_guiText;
 	sf::View m_view;
+	SpriteBatch m_spriteBatch; // Every actor sprite of the frame, drawn in one call per texture
+	LabelRenderer m_labelRenderer; // Every actor label of the frame, drawn in one call
+	Objects m_visibleColliders; // Found by the broad phase inside the view this frame
+	std::vector<Actor_Base*> m_visibleActors; // Inside the view this frame, in simulation order
 	sf::Vector2u m_windowSize;
 
 	EngineState m_state;
 	unsigned m_fpsLimit;
 
+	OrganismStore m_organismStore; // Hot organism state; declared before the actors so it outlives them
 	Actors  m_actors;
 	Actors  m_spawnList;
+	JobSystem m_jobSystem;
+	std::vector<ActorUpdateBuffer> m_updateBuffers; // One per chunk of m_actors
 	CollisionManager m_collisionManager;
 	SharedContext m_context;
 
@@ -47,25 +71,69 @@ private:
 	sf::Clock m_clock;
 	sf::Time m_elapsed;
 
+	bool m_isHeadless; // Runs the simulation without window, textures, fonts nor framerate limit
+	float m_tickDuration; // Fixed simulation time step, independent of the framerate
+	unsigned long long m_tickCount; // Simulation ticks run so far
+	float m_simulationSpeed; // Simulated seconds per real second; unlimited if 0
+	float m_accumulator; // Scaled real time not yet consumed by simulation ticks
+	float m_interpolation; // [0 1] How far between the previous and current tick the actors are drawn
+
 	Keyboard m_keyboard;
 
 	EventHandler m_eventHandler;
 
-	RandomGenerator m_rng;
+	RandomGenerator m_rng; // Seeded with the run seed
 	ResourceHolder m_resourceHolder;
 
+	ScenarioSettings m_scenarioSettings;
 	std::unique_ptr<Scenario_Basic> m_scenario;
 
+	std::array<Snapshot, 2> m_snapshots; // Double buffer: one is captured while the other may still be being written
+	std::size_t m_snapshotBuffer; // The one captured next
+	std::future<bool> m_snapshotWrite; // Declared after the buffers, so it waits for the write before they go away
+	std::string m_startSnapshot; // Loaded instead of spawning the scenario's initial population, if any
+
+	TelemetryWriter m_telemetry; // Records every tick while open
+
+	Profiler m_profiler; // Timings of the engine phases
+	bool m_isProfilerShown;
+	sf::Clock m_profilerRefresh; // The overlay text is rebuilt a few times per second, not every frame
+
+	static thread_local ActorUpdateBuffer* s_updateBuffer;
 	static const ActionFactory s_actions;
 	static const StateNames s_stateNames; // Map for engine states string names and ids
 
 public:
-	Engine(const sf::Vector2u& t_windowSize, const std::string& t_windowName);
+	Engine(const sf::Vector2u& t_windowSize, const std::string& t_windowName, bool t_isHeadless = false,
+		unsigned t_numWorkers = JobSystem::getDefaultNumWorkers(), // Worker threads used for the actor update
+		const std::uint64_t& t_seed = RandomGenerator::makeSeed(), // Drives every random source of the run
+		const std::string& t_snapshot = "", // Resumes the run saved in it; the seed then comes from the snapshot
+		const ScenarioSettings& t_scenario = ScenarioSettings());
 	void init();
 
 	// Contains the main loop
 	void run();
+
+	// Runs update() in a tight fixed step loop until either budget is spent (0 = unlimited, but not both)
+	void runHeadless(const unsigned long long& t_maxTicks, const float& t_maxSimulatedTime = 0.f);
+
+	// Copies the world as it is now and writes it to disk in the background; the simulation doesn't wait for the disk
+	void saveSnapshot(const std::string& t_fileName);
+	bool waitForSnapshotWrite(); // Whether the last snapshot (if any) was written
+
+	// Streams population aggregates every tick, and a sample of the organisms every t_sampleInterval ticks, until the engine is gone
+	bool openTelemetry(const std::string& t_fileName, const unsigned& t_sampleInterval = 30U);
+
+	Profiler& getProfiler();
+	bool writeProfile(const std::string& t_fileName)const; // p50/p99 of every phase over the last frames, as JSON
 private:
+	void captureSnapshot(Snapshot& t_out_snapshot)const;
+	bool loadSnapshot(const std::string& t_fileName); // Replaces every actor; only meant for start-up
+	void clearActors(); // Drops every actor without any destruction effect
+
+	void spawnPendingActors(); // Commits the spawn list in a single pass
+	void updateActors(const float& t_elapsed); // Removes the destroyed actors, then updates the rest across the job system
+	void applyUpdateBuffers(); // Merges the side effects of the parallel update in chunk order
 	bool parseBindings(const std::string& t_fileNameWithPath, const std::string& t_bindingIdentifier = "BIND");
 
 public:
@@ -79,19 +147,35 @@ public:
 	unsigned getMaxFramerate()const;
 	void setMaxFramerate(const unsigned& t_fps);
 	sf::Time getElapsed()const;
+	bool isHeadless()const;
+	float getTickDuration()const;
+	void setTickDuration(const float& t_seconds);
+	const unsigned long long& getTickCount()const;
+	const std::uint64_t& getSeed()const;
+	float getSimulationSpeed()const;
+	void setSimulationSpeed(const float& t_speed); // 0 = as many ticks as fit in a frame
 	const sf::FloatRect& getSimulationRect()const;
 	void spawnActor(ActorPtr t_actor);
+	void defer(Job t_job); // Runs t_job after the parallel actor update, or right away outside of it
+	static ActorUpdateBuffer* getUpdateBuffer(); // Buffer of the chunk being updated by this thread; nullptr outside the actor update
+	unsigned getNumWorkers()const;
 	void resetView();
 
 	const Scenario_Basic& getScenario()const;
 	Scenario_Basic& getScenario();
+	OrganismStore& getOrganismStore();
+	CollisionManager& getCollisionManager();
+	SharedContext& getContext();
 
 	sf::RenderWindow& getWindow();
 	const EngineState& getState()const;
+	void setState(const EngineState& t_state); // E.g. to drive update() from outside of the engine's own loops
 
 	void pollEvents();
+	void waitForResources(); // Keeps the window responsive while resources load in the background
 	void render();
-	void update();
+	void update(); // Advances the simulation by a single fixed tick
+	void advanceSimulation(); // Runs as many ticks as the real frame time (scaled by the simulation speed) allows
 
 	bool executeAction(const ActionId& t_id, const EventInfo& t_info); // Umbrella for all the actions
 	ActionCallback getActionCallback(const EngineState& t_state, const ActionId& t_id); // * See coment bellow
@@ -128,6 +212,12 @@ private:
 	void Action_ZoomOut_Paused(const EventInfo& t_info);
 	void Action_ResetZoom(const EventInfo& t_info);
 	void Action_ResetZoom_Paused(const EventInfo& t_info);
+	void Action_SpeedUp(const EventInfo& t_info);
+	void Action_SpeedUp_Paused(const EventInfo& t_info);
+	void Action_SpeedDown(const EventInfo& t_info);
+	void Action_SpeedDown_Paused(const EventInfo& t_info);
+	void Action_ToggleProfiler(const EventInfo& t_info);
+	void Action_ToggleProfiler_Paused(const EventInfo& t_info);
 	void Action_Save(const EventInfo& t_info);
 	void Action_Quit(const EventInfo& t_info);
 	void Action_INVALID_ACTION(const EventInfo& t_info);
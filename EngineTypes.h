@@ -46,6 +46,12 @@ enum class ActionId {
 	ZoomOut_Paused,
 	ResetZoom,
 	ResetZoom_Paused,
+	SpeedUp,
+	SpeedUp_Paused,
+	SpeedDown,
+	SpeedDown_Paused,
+	ToggleProfiler,
+	ToggleProfiler_Paused,
 	Save,
 	Quit,
 	ACTION_COUNT
@@ -5,17 +5,44 @@
 #include "CollisionManager.h"
 #include "Engine.h"
 #include "Scenario_Basic.h"
+#include "Snapshot.h"
 
 static const std::string S_FOOD_TEXTURE{ "Texture_food" };
+static const std::string S_FOOD_LABEL{ "Food: {}" }; // Energy
 static const sf::Color S_FOOD_COLOR{ 255,255,255,255 };
 static const float S_INFINITY{ INFINITY };
 
 ////////////////////////////////////////////////////////////
-unsigned Food::s_numFood{ 0U };
+std::atomic<unsigned> Food::s_numFood{ 0U };
 
 ////////////////////////////////////////////////////////////
 unsigned Food::getNumFood() { return s_numFood; }
 
+////////////////////////////////////////////////////////////
+void Food::setNumFood(const unsigned& t_numFood) { s_numFood = t_numFood; }
+
+////////////////////////////////////////////////////////////
+std::unique_ptr<Food> Food::makeFromSnapshot(SharedContext& t_context, const FoodSnapshot& t_snapshot) {
+	auto food{ std::make_unique<Food>(t_context, t_snapshot.m_position, t_snapshot.m_rotation, t_snapshot.m_energy, t_snapshot.m_duration) };
+	food->m_age = t_snapshot.m_age;
+	food->m_wasEaten = t_snapshot.m_wasEaten;
+	food->m_destroy = t_snapshot.m_destroy;
+	food->setColor(t_snapshot.m_color);
+	return food;
+}
+
+////////////////////////////////////////////////////////////
+void Food::writeSnapshot(FoodSnapshot& t_out_snapshot)const {
+	t_out_snapshot.m_position = m_position;
+	t_out_snapshot.m_rotation = m_rotation;
+	t_out_snapshot.m_color = m_color;
+	t_out_snapshot.m_destroy = m_destroy;
+	t_out_snapshot.m_energy = m_energy;
+	t_out_snapshot.m_age = m_age;
+	t_out_snapshot.m_duration = m_duration;
+	t_out_snapshot.m_wasEaten = m_wasEaten;
+}
+
 ////////////////////////////////////////////////////////////
 bool Food::canSpawn(SharedContext& t_context) const { return t_context.m_engine->getScenario().getEnergy() >= m_energy; } // Check if there is enough energy in the environment to spawn
 
@@ -51,11 +78,13 @@ Food::Food(SharedContext& t_context,
 	m_wasEaten{ false }
 {
 	m_actorType = ActorType::Food;
-	setTextString("Food: " + std::to_string(static_cast<int>(m_energy)));
-	m_text.setCharacterSize(10U);
+	setTextString(S_FOOD_LABEL);
 	updateCollider();
 }
 
+////////////////////////////////////////////////////////////
+void Food::updateLabel() { m_label.setValue(0U, m_energy); }
+
 ////////////////////////////////////////////////////////////
 const float& Food::getEnergy()const { return m_energy; }
 
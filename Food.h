@@ -1,12 +1,15 @@
 #ifndef FOOD_H
 #define FOOD_H
 
+#include <atomic>
 #include "Actor_Base.h"
 #include "Collider.h"
 
+struct FoodSnapshot;
+
 class Food : public Actor_Base {
 
-	static unsigned s_numFood;
+	static std::atomic<unsigned> s_numFood; // Expired food decrements it from the parallel actor update
 
 	float m_energy; // Energy granted to the eater
 	float m_age;
@@ -33,6 +36,9 @@ public:
 	void setWasEaten(bool t_wasEaten);
 
 	static unsigned getNumFood();
+	static void setNumFood(const unsigned& t_numFood); // When loading a snapshot, whose food is placed without spawning
+	static std::unique_ptr<Food> makeFromSnapshot(SharedContext& t_context, const FoodSnapshot& t_snapshot);
+	void writeSnapshot(FoodSnapshot& t_out_snapshot)const;
 
 	bool canSpawn(SharedContext& t_context)const;
 	void onSpawn(SharedContext& t_context);
@@ -42,6 +48,9 @@ public:
 	void updateCollider();
 
 	ActorPtr clone(SharedContext& t_context);
+
+protected:
+	void updateLabel();
 };
 
 #endif // !FOOD_H
\ No newline at end of file
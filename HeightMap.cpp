@@ -1,4 +1,5 @@
 #include "HeightMap.h"
+#include <cmath>
 
 
 
@@ -45,7 +46,7 @@ double HeightMap::standtDev() const {
 	for (const auto& val : m_heights) {
 		sum += (val - ave) * (val - ave);
 	}
-	return sqrt(sum / (m_width * m_height));
+	return std::sqrt(sum / (m_width * m_height));
 }
 
 
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include "JobSystem.h"
+
+////////////////////////////////////////////////////////////
+thread_local std::size_t JobSystem::s_queueIndex{ 0U };
+
+////////////////////////////////////////////////////////////
+JobSystem::JobSystem(unsigned t_numWorkers) :
+	m_queuedJobs{ 0 },
+	m_isRunning{ true },
+	m_nextQueue{ 0U }
+{
+	for (unsigned i{ 0U }; i <= t_numWorkers; i++) { m_queues.emplace_back(std::make_unique<WorkQueue>()); }
+	for (unsigned i{ 1U }; i <= t_numWorkers; i++) { m_workers.emplace_back(&JobSystem::workerLoop, this, i); }
+}
+
+////////////////////////////////////////////////////////////
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock{ m_wakeMutex };
+		m_isRunning = false;
+	}
+	m_wakeCondition.notify_all();
+	for (auto& worker : m_workers) { worker.join(); }
+}
+
+////////////////////////////////////////////////////////////
+unsigned JobSystem::getNumWorkers()const { return static_cast<unsigned>(m_workers.size()); }
+
+////////////////////////////////////////////////////////////
+unsigned JobSystem::getDefaultNumWorkers() {
+	const unsigned hardwareThreads{ std::thread::hardware_concurrency() };
+	return (hardwareThreads > 1U ? hardwareThreads - 1U : 0U);
+}
+
+////////////////////////////////////////////////////////////
+std::size_t JobSystem::getNumChunks(const std::size_t& t_count, const std::size_t& t_grainSize) {
+	return (t_count + t_grainSize - 1U) / t_grainSize;
+}
+
+////////////////////////////////////////////////////////////
+void JobSystem::parallelFor(const std::size_t& t_count, const std::size_t& t_grainSize, const RangeJob& t_job) {
+	const std::size_t numChunks{ getNumChunks(t_count, t_grainSize) };
+	if (numChunks == 0U) { return; }
+
+	// Nothing to share: skip the queues altogether
+	if (m_workers.empty() || numChunks == 1U) {
+		for (std::size_t chunk{ 0U }; chunk < numChunks; chunk++) {
+			const std::size_t begin{ chunk * t_grainSize };
+			t_job(begin, std::min(begin + t_grainSize, t_count), chunk);
+		}
+		return;
+	}
+
+	std::atomic<std::size_t> remaining{ numChunks };
+	for (std::size_t chunk{ 0U }; chunk < numChunks; chunk++) {
+		push([&t_job, &remaining, chunk, t_grainSize, t_count]() {
+			const std::size_t begin{ chunk * t_grainSize };
+			t_job(begin, std::min(begin + t_grainSize, t_count), chunk);
+			remaining--;
+		});
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{ m_wakeMutex };
+		m_queuedJobs += static_cast<long long>(numChunks);
+	}
+	m_wakeCondition.notify_all();
+
+	// Help out until every chunk is done
+	Job job;
+	while (remaining > 0U) {
+		if (pop(job)) { job(); }
+		else { std::this_thread::yield(); }
+	}
+}
+
+////////////////////////////////////////////////////////////
+void JobSystem::push(Job t_job) {
+	auto& queue{ *m_queues[m_nextQueue] };
+	m_nextQueue = (m_nextQueue + 1U) % m_queues.size();
+
+	std::lock_guard<std::mutex> lock{ queue.m_mutex };
+	queue.m_jobs.emplace_back(std::move(t_job));
+}
+
+////////////////////////////////////////////////////////////
+bool JobSystem::pop(Job& t_out_job) {
+	const std::size_t numQueues{ m_queues.size() };
+	for (std::size_t i{ 0U }; i < numQueues; i++) {
+		const std::size_t index{ (s_queueIndex + i) % numQueues };
+		auto& queue{ *m_queues[index] };
+
+		std::lock_guard<std::mutex> lock{ queue.m_mutex };
+		if (queue.m_jobs.empty()) { continue; }
+
+		// Own jobs are taken from the back (most recent), stolen ones from the front
+		if (index == s_queueIndex) {
+			t_out_job = std::move(queue.m_jobs.back());
+			queue.m_jobs.pop_back();
+		}
+		else {
+			t_out_job = std::move(queue.m_jobs.front());
+			queue.m_jobs.pop_front();
+		}
+		m_queuedJobs--;
+		return true;
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+void JobSystem::workerLoop(const std::size_t& t_queueIndex) {
+	s_queueIndex = t_queueIndex;
+
+	Job job;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock{ m_wakeMutex };
+			m_wakeCondition.wait(lock, [this]() { return !m_isRunning || m_queuedJobs > 0; });
+			if (!m_isRunning) { return; }
+		}
+		while (pop(job)) { job(); }
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Job = std::function<void()>;
+using RangeJob = std::function<void(const std::size_t& t_begin, const std::size_t& t_end, const std::size_t& t_chunk)>;
+
+// Pool of worker threads, each with its own job queue. Idle workers steal from the front of the other queues,
+//	while owners pop from the back, so a big range split in chunks ends up balanced across every core.
+class JobSystem {
+
+	struct WorkQueue {
+		std::mutex m_mutex;
+		std::deque<Job> m_jobs;
+	};
+
+	std::vector<std::thread> m_workers;
+	std::vector<std::unique_ptr<WorkQueue>> m_queues; // [0] belongs to the thread that calls parallelFor()
+	std::atomic<long long> m_queuedJobs; // May go briefly negative when a job is stolen before being counted
+	std::atomic<bool> m_isRunning;
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+	std::size_t m_nextQueue; // Round robin for pushed jobs
+
+	static thread_local std::size_t s_queueIndex;
+
+	JobSystem(const JobSystem& t_rhs) = delete;
+
+public:
+	JobSystem(unsigned t_numWorkers = getDefaultNumWorkers()); // Threads besides the calling one; 0 = run everything in place
+	~JobSystem();
+
+	unsigned getNumWorkers()const;
+	static unsigned getDefaultNumWorkers(); // One less than the hardware threads
+
+	// Splits [0 t_count) in chunks of t_grainSize and blocks until all of them are done. The calling thread works too.
+	//	Chunks are fixed by the count and grain size only, so per chunk results don't depend on the number of workers.
+	void parallelFor(const std::size_t& t_count, const std::size_t& t_grainSize, const RangeJob& t_job);
+	static std::size_t getNumChunks(const std::size_t& t_count, const std::size_t& t_grainSize);
+
+private:
+	void push(Job t_job);
+	bool pop(Job& t_out_job); // Own queue first, then steal
+	void workerLoop(const std::size_t& t_queueIndex);
+};
+
+#endif // !JOB_SYSTEM_H
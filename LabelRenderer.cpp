@@ -0,0 +1,204 @@
+#include "LabelRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+static const char S_FIRST_GLYPH{ ' ' };
+static const char S_LAST_GLYPH{ '~' };
+static const char S_MISSING_GLYPH{ '?' };
+static const std::size_t S_MAX_DECIMALS{ 6U };
+static const float S_MAX_VALUE{ 1e15f }; // Past this values are drawn as '?'
+
+////////////////////////////////////////////////////////////
+void Label::setText(const std::string& t_text) {
+	if (t_text == m_text && !m_segments.empty()) { return; } // Keeps the geometry of the renderer
+	m_text = t_text;
+	m_segments.clear();
+
+	std::size_t numValues{ 0U };
+	std::size_t begin{ 0U };
+	auto pushText{ [this, &begin](const std::size_t& t_end) {
+		if (t_end > begin) { m_segments.push_back({ SegmentType::Text, begin, t_end - begin, nullptr }); }
+	} };
+	for (std::size_t i{ 0U }; i < m_text.size(); i++) {
+		if (m_text[i] == '\n') {
+			pushText(i);
+			m_segments.push_back({ SegmentType::NewLine, 0U, 0U, nullptr });
+			begin = i + 1U;
+		}
+		else if (m_text[i] == '{') {
+			const std::size_t end{ m_text.find('}', i) };
+			if (end == std::string::npos) { break; } // The rest is plain text
+			std::size_t decimals{ 0U };
+			if (end > i + 2U && m_text[i + 1U] == '.') { decimals = std::min(static_cast<std::size_t>(std::atoi(m_text.c_str() + i + 2U)), S_MAX_DECIMALS); }
+			pushText(i);
+			m_segments.push_back({ SegmentType::Value, numValues++, decimals, nullptr });
+			i = end;
+			begin = end + 1U;
+		}
+	}
+	pushText(m_text.size());
+	m_values.assign(numValues, 0.f);
+}
+
+////////////////////////////////////////////////////////////
+const std::string& Label::getText()const { return m_text; }
+
+////////////////////////////////////////////////////////////
+void Label::setValue(const std::size_t& t_index, const float& t_value) {
+	if (t_index < m_values.size()) { m_values[t_index] = t_value; }
+}
+
+
+////////////////////////////////////////////////////////////
+LabelRenderer::LabelRenderer() : m_font{ nullptr }, m_characterSize{ 0U }, m_lineSpacing{ 0.f }, m_glyphs{} {}
+
+////////////////////////////////////////////////////////////
+void LabelRenderer::init(const sf::Font& t_font, const unsigned& t_characterSize, const sf::Color& t_color) {
+	m_font = &t_font;
+	m_characterSize = t_characterSize;
+	m_color = t_color;
+	m_lineSpacing = t_font.getLineSpacing(t_characterSize);
+	m_cache.clear();
+	for (char c{ S_FIRST_GLYPH }; c <= S_LAST_GLYPH; c++) {
+		const sf::Glyph& glyph{ t_font.getGlyph(static_cast<sf::Uint32>(c), t_characterSize, false) };
+		m_glyphs[static_cast<std::size_t>(c)] = { glyph.bounds, sf::FloatRect(glyph.textureRect), glyph.advance };
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool LabelRenderer::isInitialized()const { return m_font != nullptr; }
+
+////////////////////////////////////////////////////////////
+const unsigned& LabelRenderer::getCharacterSize()const { return m_characterSize; }
+
+////////////////////////////////////////////////////////////
+void LabelRenderer::clear() { m_vertices.clear(); }
+
+////////////////////////////////////////////////////////////
+void LabelRenderer::add(Label& t_label, const sf::Vector2f& t_bottomCenter) {
+	if (!m_font || t_label.m_segments.empty()) { return; }
+	char digits[32];
+
+	std::size_t numLines{ 1U };
+	for (const auto& segment : t_label.m_segments) {
+		if (segment.m_type == Label::SegmentType::NewLine) { numLines++; }
+	}
+	float baseline{ t_bottomCenter.y - numLines * m_lineSpacing + m_characterSize };
+
+	auto lineBegin{ t_label.m_segments.begin() };
+	while (true) {
+		// Measure the line, so it can be centered
+		auto lineEnd{ lineBegin };
+		float width{ 0.f };
+		for (; lineEnd != t_label.m_segments.end() && lineEnd->m_type != Label::SegmentType::NewLine; lineEnd++) {
+			if (lineEnd->m_type == Label::SegmentType::Text) {
+				if (!lineEnd->m_geometry) { lineEnd->m_geometry = &getGeometry(t_label, *lineEnd); }
+				width += lineEnd->m_geometry->m_advance;
+			}
+			else {
+				const unsigned length{ formatValue(digits, t_label.m_values[lineEnd->m_begin], lineEnd->m_length) };
+				for (unsigned i{ 0U }; i < length; i++) { width += getGlyph(digits[i]).m_advance; }
+			}
+		}
+
+		// Then write it
+		sf::Vector2f pen{ std::floor(t_bottomCenter.x - width * 0.5f), std::floor(baseline) };
+		for (auto it{ lineBegin }; it != lineEnd; it++) {
+			if (it->m_type == Label::SegmentType::Text) {
+				for (const auto& vertex : it->m_geometry->m_vertices) {
+					m_vertices.emplace_back(vertex.position + pen, vertex.color, vertex.texCoords);
+				}
+				pen.x += it->m_geometry->m_advance;
+			}
+			else {
+				const unsigned length{ formatValue(digits, t_label.m_values[it->m_begin], it->m_length) };
+				for (unsigned i{ 0U }; i < length; i++) {
+					const LabelGlyph& glyph{ getGlyph(digits[i]) };
+					appendGlyph(m_vertices, glyph, pen);
+					pen.x += glyph.m_advance;
+				}
+			}
+		}
+
+		if (lineEnd == t_label.m_segments.end()) { break; }
+		lineBegin = lineEnd + 1;
+		baseline += m_lineSpacing;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void LabelRenderer::draw(sf::RenderTarget& t_target, sf::RenderStates t_states)const {
+	if (!m_font || m_vertices.empty()) { return; }
+	t_states.texture = &m_font->getTexture(m_characterSize);
+	t_target.draw(m_vertices.data(), m_vertices.size(), sf::Triangles, t_states);
+}
+
+////////////////////////////////////////////////////////////
+const LabelGlyph& LabelRenderer::getGlyph(const char& t_character)const {
+	return m_glyphs[static_cast<std::size_t>(t_character >= S_FIRST_GLYPH && t_character <= S_LAST_GLYPH ? t_character : S_MISSING_GLYPH)];
+}
+
+////////////////////////////////////////////////////////////
+const LabelGeometry& LabelRenderer::getGeometry(const Label& t_label, const Label::Segment& t_segment) {
+	m_key.assign(t_label.m_text, t_segment.m_begin, t_segment.m_length);
+	auto it{ m_cache.find(m_key) };
+	if (it != m_cache.end()) { return it->second; }
+
+	// Laid out like sf::Text does, from the pen on the baseline
+	LabelGeometry geometry{ {}, 0.f };
+	char previous{ 0 };
+	for (const char& c : m_key) {
+		if (previous) { geometry.m_advance += m_font->getKerning(static_cast<sf::Uint32>(previous), static_cast<sf::Uint32>(c), m_characterSize); }
+		previous = c;
+		const LabelGlyph& glyph{ getGlyph(c) };
+		appendGlyph(geometry.m_vertices, glyph, { geometry.m_advance, 0.f });
+		geometry.m_advance += glyph.m_advance;
+	}
+	return m_cache.emplace(m_key, std::move(geometry)).first->second;
+}
+
+////////////////////////////////////////////////////////////
+unsigned LabelRenderer::formatValue(char* t_out_digits, const float& t_value, const std::size_t& t_decimals) {
+	if (!std::isfinite(t_value) || std::abs(t_value) >= S_MAX_VALUE) {
+		t_out_digits[0] = S_MISSING_GLYPH;
+		return 1U;
+	}
+	long long scale{ 1 };
+	for (std::size_t i{ 0U }; i < t_decimals; i++) { scale *= 10; }
+	long long value{ std::llround(std::abs(static_cast<double>(t_value)) * scale) };
+	const bool isNegative{ t_value < 0.f && value != 0 }; // No -0
+
+	// Digits from the last, then reversed
+	unsigned length{ 0U };
+	for (std::size_t i{ 0U }; i < t_decimals; i++) {
+		t_out_digits[length++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+	if (t_decimals) { t_out_digits[length++] = '.'; }
+	do {
+		t_out_digits[length++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value);
+	if (isNegative) { t_out_digits[length++] = '-'; }
+	for (unsigned i{ 0U }; i < length / 2U; i++) { std::swap(t_out_digits[i], t_out_digits[length - 1U - i]); }
+	return length;
+}
+
+////////////////////////////////////////////////////////////
+void LabelRenderer::appendGlyph(std::vector<sf::Vertex>& t_out_vertices, const LabelGlyph& t_glyph, const sf::Vector2f& t_pen)const {
+	if (t_glyph.m_bounds.width <= 0.f || t_glyph.m_bounds.height <= 0.f) { return; } // Spaces
+	const sf::FloatRect& bounds{ t_glyph.m_bounds };
+	const sf::FloatRect& texture{ t_glyph.m_textureRect };
+	const sf::Vertex topLeft{ t_pen + sf::Vector2f(bounds.left, bounds.top), m_color, sf::Vector2f(texture.left, texture.top) };
+	const sf::Vertex topRight{ t_pen + sf::Vector2f(bounds.left + bounds.width, bounds.top), m_color, sf::Vector2f(texture.left + texture.width, texture.top) };
+	const sf::Vertex bottomLeft{ t_pen + sf::Vector2f(bounds.left, bounds.top + bounds.height), m_color, sf::Vector2f(texture.left, texture.top + texture.height) };
+	const sf::Vertex bottomRight{ t_pen + sf::Vector2f(bounds.left + bounds.width, bounds.top + bounds.height), m_color,
+		sf::Vector2f(texture.left + texture.width, texture.top + texture.height) };
+	t_out_vertices.push_back(topLeft);
+	t_out_vertices.push_back(topRight);
+	t_out_vertices.push_back(bottomLeft);
+	t_out_vertices.push_back(bottomLeft);
+	t_out_vertices.push_back(topRight);
+	t_out_vertices.push_back(bottomRight);
+}
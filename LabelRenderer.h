@@ -0,0 +1,78 @@
+#ifndef LABEL_RENDERER_H
+#define LABEL_RENDERER_H
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+struct LabelGeometry; // Laid out text, cached by the renderer
+
+// Text of a nametag: static text with numeric fields. "{}" is a whole number and "{.N}" one with N decimals, e.g.
+//	"Energy: {} / {}". The text is parsed when set; the fields are then updated in place, without building strings.
+//	Setting it touches no font, so it may be done from the update workers.
+class Label {
+	friend class LabelRenderer;
+
+	enum class SegmentType { Text, Value, NewLine };
+	struct Segment {
+		SegmentType m_type;
+		std::size_t m_begin; // Text segments: range in m_text; values: index in m_values
+		std::size_t m_length; // Text segments; decimals for values
+		const LabelGeometry* m_geometry; // Text segments, once the renderer saw them
+	};
+
+	std::string m_text;
+	std::vector<Segment> m_segments;
+	std::vector<float> m_values;
+
+public:
+	void setText(const std::string& t_text);
+	const std::string& getText()const;
+	void setValue(const std::size_t& t_index, const float& t_value); // Fields are numbered in order from 0
+};
+
+struct LabelGlyph {
+	sf::FloatRect m_bounds; // From the pen, on the baseline
+	sf::FloatRect m_textureRect;
+	float m_advance;
+};
+
+struct LabelGeometry {
+	std::vector<sf::Vertex> m_vertices; // Two triangles per glyph, from the pen at the start of the text
+	float m_advance;
+};
+
+// Draws every nametag of a frame in a single call. Glyphs are taken from the font once, and each distinct text
+//	is laid out once and cached; per frame, labels only copy their cached vertices and write their digits.
+class LabelRenderer : public sf::Drawable {
+
+	const sf::Font* m_font;
+	unsigned m_characterSize;
+	sf::Color m_color;
+	float m_lineSpacing;
+	std::array<LabelGlyph, 128> m_glyphs; // ASCII; anything else is drawn as '?'
+	std::unordered_map<std::string, LabelGeometry> m_cache; // By text; nodes don't move, so labels keep pointers to them
+	std::string m_key; // Reused to look texts up
+	std::vector<sf::Vertex> m_vertices; // Of the frame, as triangles
+
+public:
+	LabelRenderer();
+	void init(const sf::Font& t_font, const unsigned& t_characterSize, const sf::Color& t_color); // Before the first label
+	bool isInitialized()const;
+	const unsigned& getCharacterSize()const;
+
+	void clear(); // Keeps the memory of the frame's vertices
+	void add(Label& t_label, const sf::Vector2f& t_bottomCenter); // Lines are centered; the last one ends at t_bottomCenter
+
+	virtual void draw(sf::RenderTarget& t_target, sf::RenderStates t_states)const;
+
+private:
+	const LabelGlyph& getGlyph(const char& t_character)const;
+	const LabelGeometry& getGeometry(const Label& t_label, const Label::Segment& t_segment);
+	static unsigned formatValue(char* t_out_digits, const float& t_value, const std::size_t& t_decimals); // Returns the length
+	void appendGlyph(std::vector<sf::Vertex>& t_out_vertices, const LabelGlyph& t_glyph, const sf::Vector2f& t_pen)const;
+};
+
+#endif // !LABEL_RENDERER_H
@@ -0,0 +1,95 @@
+#include "MappedFile.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+
+#include <Windows.h>
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif // WINDOWS
+
+////////////////////////////////////////////////////////////
+MappedFile::MappedFile() : m_data{ nullptr }, m_size{ 0U }, m_file{ nullptr }, m_mapping{ nullptr } {}
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile() { close(); }
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(const std::string& t_fileName) {
+	close();
+	HANDLE file{ CreateFileA(t_fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL) };
+	if (file == INVALID_HANDLE_VALUE) { return false; }
+	m_file = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+		close();
+		return false;
+	}
+	m_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	const void* data{ m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr };
+	if (!data) {
+		close();
+		return false;
+	}
+	m_data = static_cast<const std::uint8_t*>(data);
+	m_size = static_cast<std::size_t>(size.QuadPart);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void MappedFile::close() {
+	if (m_data) { UnmapViewOfFile(m_data); }
+	if (m_mapping) { CloseHandle(m_mapping); }
+	if (m_file) { CloseHandle(m_file); }
+	m_data = nullptr;
+	m_size = 0U;
+	m_file = nullptr;
+	m_mapping = nullptr;
+}
+
+#else
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(const std::string& t_fileName) {
+	close();
+	const int file{ ::open(t_fileName.c_str(), O_RDONLY) };
+	if (file < 0) { return false; }
+
+	struct stat info;
+	void* data{ MAP_FAILED };
+	if (fstat(file, &info) == 0 && info.st_size > 0) {
+		data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	}
+	::close(file); // The mapping keeps the file alive
+	if (data == MAP_FAILED) { return false; }
+
+	m_data = static_cast<const std::uint8_t*>(data);
+	m_size = static_cast<std::size_t>(info.st_size);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void MappedFile::close() {
+	if (m_data) { munmap(const_cast<std::uint8_t*>(m_data), m_size); }
+	m_data = nullptr;
+	m_size = 0U;
+}
+
+#endif // WINDOWS
+
+////////////////////////////////////////////////////////////
+bool MappedFile::isOpen()const { return m_data != nullptr; }
+
+////////////////////////////////////////////////////////////
+const std::uint8_t* MappedFile::getData()const { return m_data; }
+
+////////////////////////////////////////////////////////////
+const std::size_t& MappedFile::getSize()const { return m_size; }
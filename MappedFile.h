@@ -0,0 +1,30 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only view of a whole file mapped into memory: its pages are loaded by the OS as they are touched,
+//	so reading a large file costs no copy nor allocation of its own
+class MappedFile {
+
+	const std::uint8_t* m_data;
+	std::size_t m_size;
+	void* m_file; // OS handles; unused on POSIX
+	void* m_mapping;
+
+	MappedFile(const MappedFile& t_rhs) = delete;
+	MappedFile& operator=(const MappedFile& t_rhs) = delete;
+
+public:
+	MappedFile();
+	~MappedFile();
+	bool open(const std::string& t_fileName); // Closes the file mapped before, if any
+	void close();
+	bool isOpen()const;
+	const std::uint8_t* getData()const;
+	const std::size_t& getSize()const;
+};
+
+#endif // !MAPPED_FILE_H
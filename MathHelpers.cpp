@@ -45,7 +45,7 @@ namespace mat {
 
 	////////////////////////////////////////////////////////////
 	template <typename T>
-	float vec2d_magnitude(const sf::Vector2<T> t_vec) { return std::sqrtf(t_vec.x * t_vec.x + t_vec.y * t_vec.y); }
+	float vec2d_magnitude(const sf::Vector2<T> t_vec) { return std::sqrt(t_vec.x * t_vec.x + t_vec.y * t_vec.y); }
 
 	////////////////////////////////////////////////////////////
 	void vec2d_unitary(const float& t_i, const float& t_j, float& t_out_i, float& t_out_j) {
@@ -114,8 +114,8 @@ namespace mat {
 
 	////////////////////////////////////////////////////////////
 	void to_polar(const float& t_i, const float& t_j, float& t_out_radius, float& t_out_degrees) {
-		t_out_radius = std::sqrtf(t_i * t_i + t_j * t_j);
-		t_out_degrees = std::atanf(t_i / t_j) * TO_DEGREES;
+		t_out_radius = std::sqrt(t_i * t_i + t_j * t_j);
+		t_out_degrees = std::atan(t_i / t_j) * TO_DEGREES;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -126,7 +126,7 @@ namespace mat {
 
 	////////////////////////////////////////////////////////////
 	float distance(const float& t_x1, const float& t_y1, const float& t_x2, const float& t_y2) {
-		return std::sqrtf((t_x1 - t_x2) * (t_x1 - t_x2) + (t_y1 - t_y2) * (t_y1 - t_y2));
+		return std::sqrt((t_x1 - t_x2) * (t_x1 - t_x2) + (t_y1 - t_y2) * (t_y1 - t_y2));
 	}
 
 	////////////////////////////////////////////////////////////
@@ -134,4 +134,25 @@ namespace mat {
 		return distance(t_pos1.x, t_pos1.y, t_pos2.x, t_pos2.y);
 	}
 
+	////////////////////////////////////////////////////////////
+	float toroidalDelta(const float& t_from, const float& t_to, const float& t_period) {
+		float delta{ t_to - t_from };
+		if (t_period <= 0.f) { return delta; }
+		const float halfPeriod{ t_period * 0.5f };
+		if (delta > halfPeriod) { delta -= t_period; }
+		else if (delta < -halfPeriod) { delta += t_period; }
+		return delta;
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::Vector2f toroidalDelta(const sf::Vector2f& t_from, const sf::Vector2f& t_to, const sf::Vector2f& t_worldSize) {
+		return { toroidalDelta(t_from.x, t_to.x, t_worldSize.x), toroidalDelta(t_from.y, t_to.y, t_worldSize.y) };
+	}
+
+	////////////////////////////////////////////////////////////
+	float toroidalDistanceSquared(const sf::Vector2f& t_pos1, const sf::Vector2f& t_pos2, const sf::Vector2f& t_worldSize) {
+		const sf::Vector2f delta{ toroidalDelta(t_pos1, t_pos2, t_worldSize) };
+		return delta.x * delta.x + delta.y * delta.y;
+	}
+
 }
\ No newline at end of file
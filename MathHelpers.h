@@ -60,6 +60,12 @@ namespace mat {
 
 	float distance(const sf::Vector2f& t_pos1, const sf::Vector2f& t_pos2);
 
+	float toroidalDelta(const float& t_from, const float& t_to, const float& t_period); // Shortest signed t_to - t_from on a loop; plain difference if t_period <= 0
+
+	sf::Vector2f toroidalDelta(const sf::Vector2f& t_from, const sf::Vector2f& t_to, const sf::Vector2f& t_worldSize);
+
+	float toroidalDistanceSquared(const sf::Vector2f& t_pos1, const sf::Vector2f& t_pos2, const sf::Vector2f& t_worldSize);
+
 };
 
 ////////////////////////////////////////////////////////////
@@ -8,6 +8,10 @@
 #include "Engine.h"
 #include "Scenario_Basic.h"
 #include "PreprocessorDirectves.h"
+#include "RandomGenerator.h"
+#include "Snapshot.h"
+
+using OF = OrganismField;
 
 static const float S_TIME_ZERO{ 0.f };
 static const std::string S_DEFAULT_TEXTURE{ "Texture_organism" };
@@ -16,6 +20,18 @@ static const sf::Color S_DEFAULT_COLOR{ 255,255,255,255 };
 static const float S_DEFAULT_SIZE{ 1.f };
 static const float S_DEFAULT_DESTRUCTION_DELAY{ 10.f };
 static const sf::Color S_DEATH_COLOR{70,60,50};
+static const std::string S_DEAD_SUFFIX{ " (dead)" }; // Appended to the name on death
+static const std::string S_DEBUG_LABEL{ // Fields under the name, written when drawn
+	"\nEnergy: {} / {}"
+	"\nAge   : {} / {}"
+	"\nSize  : {.2}"
+	"\nMass  : {.2}"
+	"\nRMR   : {.2}"
+	"\nMovSp : {.2}"
+	"\nRotSp : {.2}"
+	"\nDigEff: {.2}" };
+
+const float Organism::s_hungerThreshold{ 0.8f };
 
 ////////////////////////////////////////////////////////////
 Organism::Organism(
@@ -26,33 +42,104 @@ Organism::Organism(
 	const float& t_age) :
 	Actor_Base(t_context, t_position, t_rotation, S_DEFAULT_COLOR, S_DEFAULT_TEXTURE, sf::IntRect(), true, true),
 	m_name{ t_name },
-	m_age{ t_age },
-	m_ai{ std::make_unique<Ai_Organism>(t_context) },
 	m_destructionDelay{ S_DEFAULT_DESTRUCTION_DELAY },
+	m_store{ &t_context.m_engine->getOrganismStore() },
+	m_slot{ m_store->allocate(this) },
+	m_ai{ std::make_unique<Ai_Organism>() },
 	m_scenario{ &t_context.m_engine->getScenario() }
 {
+	initFields(t_age);
+
 	m_actorType = ActorType::Organism;
-	m_text.setCharacterSize(10U);
-	setTextString(m_name);
+	setLabelText();
 	setColorRGB(m_color); //Also write the HSL color
 }
 
 ////////////////////////////////////////////////////////////
-OrganismPtr Organism::makeDefaultClone(SharedContext& t_context, const std::string& t_name, const sf::Vector2f& t_position, const float& t_rotation, const float& t_age) {
-	auto o{ std::make_unique<Organism>(t_context, t_name, t_position, t_rotation, t_age) };
-	for (const auto& it : Trait_Base::getVitalTraits()) {
-		o->m_traits.addTrait(std::move(Trait_Base::cloneDefaultTrait(it)));
+Organism::Organism(SharedContext& t_context) :
+	Actor_Base(t_context, sf::Vector2f(0.f, 0.f), 0.f, S_DEFAULT_COLOR, S_DEFAULT_TEXTURE, sf::IntRect(), true, true),
+	m_destructionDelay{ S_DEFAULT_DESTRUCTION_DELAY },
+	m_store{ &t_context.m_engine->getOrganismStore() },
+	m_slot{ OrganismStore::s_noSlot },
+	m_ai{ std::make_unique<Ai_Organism>() },
+	m_scenario{ &t_context.m_engine->getScenario() }
+{
+	m_actorType = ActorType::Organism; // The rest is set by reinitialize(), when a birth takes it out of the pool
+}
+
+////////////////////////////////////////////////////////////
+Organism::~Organism() {
+	if (m_slot != OrganismStore::s_noSlot) { m_store->release(m_slot); }
+}
+
+////////////////////////////////////////////////////////////
+void Organism::reinitialize(const std::string& t_name, const sf::Vector2f& t_position, const float& t_rotation, const float& t_age) {
+	Actor_Base::reinitialize(t_position, t_rotation, S_DEFAULT_COLOR);
+	m_slot = m_store->allocate(this);
+	m_destructionDelay = S_DEFAULT_DESTRUCTION_DELAY;
+	initFields(t_age);
+
+	// The texture, font and character size are still set; the label is only rebuilt if the name changed.
+	//	Pooled organisms died, so the suffix is dropped first: offspring mostly carry the name of the dead.
+	const bool wasDead{ m_name.size() >= S_DEAD_SUFFIX.size() &&
+		m_name.compare(m_name.size() - S_DEAD_SUFFIX.size(), S_DEAD_SUFFIX.size(), S_DEAD_SUFFIX) == 0 };
+	if (wasDead) { m_name.resize(m_name.size() - S_DEAD_SUFFIX.size()); }
+	if (wasDead || m_name != t_name) {
+		m_name = t_name; // Fits in the capacity of the previous name
+		setLabelText();
 	}
+	setColorRGB(m_color);
+}
+
+////////////////////////////////////////////////////////////
+void Organism::initFields(const float& t_age) {
+	field(OF::PositionX) = m_position.x;
+	field(OF::PositionY) = m_position.y;
+	field(OF::Rotation) = m_rotation;
+	field(OF::Age) = t_age;
+	field(OF::NoiseOffset) = m_context.m_rng->generate(0.f, 100000.f);
+}
+
+////////////////////////////////////////////////////////////
+float& Organism::field(const OrganismField& t_field) { return m_store->get(t_field, m_slot); }
+
+////////////////////////////////////////////////////////////
+const float& Organism::field(const OrganismField& t_field)const { return m_store->get(t_field, m_slot); }
+
+////////////////////////////////////////////////////////////
+OrganismPtr Organism::make(SharedContext& t_context, const std::string& t_name, const sf::Vector2f& t_position, const float& t_rotation, const float& t_age) {
+	OrganismPtr o{ t_context.m_engine->getOrganismStore().reuse() };
+	if (!o) { return std::make_unique<Organism>(t_context, t_name, t_position, t_rotation, t_age); }
+	o->reinitialize(t_name, t_position, t_rotation, t_age);
+	return o;
+}
+
+////////////////////////////////////////////////////////////
+OrganismPtr Organism::makePooled(SharedContext& t_context) { return OrganismPtr{ new Organism{ t_context } }; }
+
+////////////////////////////////////////////////////////////
+OrganismPtr Organism::makeFromSnapshot(SharedContext& t_context, const OrganismSnapshot& t_snapshot, const TraitCollection& t_genome, const std::string& t_name) {
+	auto o{ make(t_context, t_name, t_snapshot.m_position, t_snapshot.m_rotation, 0.f) };
+	o->m_traits = t_genome;
+	o->m_traits.onOrganismConstruction(o.get(), 0.f); // Sprite scale, color and the derived rates; the fields get overwritten with the store
+	o->setColorRGB(t_snapshot.m_color);
+	o->m_destructionDelay = t_snapshot.m_destructionDelay;
+	o->m_destroy = t_snapshot.m_destroy;
+	return o;
+}
+
+////////////////////////////////////////////////////////////
+OrganismPtr Organism::makeDefaultClone(SharedContext& t_context, const std::string& t_name, const sf::Vector2f& t_position, const float& t_rotation, const float& t_age) {
+	auto o{ make(t_context, t_name, t_position, t_rotation, t_age) };
+	o->m_traits = Trait_Base::getDefaultTraits();
 	o->m_traits.onOrganismConstruction(o.get(), 0.f); // Update all the traits
 	return std::move(o);
 }
 
 ////////////////////////////////////////////////////////////
 OrganismPtr Organism::makeDefaultOffspring(SharedContext& t_context, const std::string& t_name, const sf::Vector2f& t_position, const float& t_rotation, const float& t_age) {
-	auto o{ std::make_unique<Organism>(t_context, t_name, t_position, t_rotation, t_age) };
-	for (const auto& it : Trait_Base::getVitalTraits()) {
-		o->m_traits.addTrait(std::move(Trait_Base::reproduceDefaultTrait(t_context, it)));
-	}
+	auto o{ make(t_context, t_name, t_position, t_rotation, t_age) };
+	Trait_Base::getDefaultTraits().reproduce(t_context, o->m_traits);
 	o->m_traits.onOrganismConstruction(o.get(), 0.f); // Update all the traits
 	return std::move(o);
 }
@@ -78,28 +165,28 @@ void Organism::setColorRGB(const sf::Color& t_color) {
 }
 
 ////////////////////////////////////////////////////////////
-const float& Organism::getMovementSpeed()const { return m_trait_movementSpeed; }
+const float& Organism::getMovementSpeed()const { return field(OF::MovementSpeed); }
 
 ////////////////////////////////////////////////////////////
-void Organism::setMovementSpeed(const float& t_movementSpeed) { m_trait_movementSpeed = t_movementSpeed; }
+void Organism::setMovementSpeed(const float& t_movementSpeed) { field(OF::MovementSpeed) = t_movementSpeed; }
 
 ////////////////////////////////////////////////////////////
-const float& Organism::getRotationSpeed()const { return m_trait_turningSpeed; }
+const float& Organism::getRotationSpeed()const { return field(OF::TurningSpeed); }
 
 ////////////////////////////////////////////////////////////
-void Organism::setRotationSpeed(const float& t_rotationSpeed) { m_trait_turningSpeed = t_rotationSpeed; }
+void Organism::setRotationSpeed(const float& t_rotationSpeed) { field(OF::TurningSpeed) = t_rotationSpeed; }
 
 ////////////////////////////////////////////////////////////
-const float& Organism::getAge()const { return m_age; }
+const float& Organism::getAge()const { return field(OF::Age); }
 
 ////////////////////////////////////////////////////////////
-void Organism::setAge(const float& t_age) { m_age = t_age; }
+void Organism::setAge(const float& t_age) { field(OF::Age) = t_age; }
 
 ////////////////////////////////////////////////////////////
-const float& Organism::getSize()const { return m_trait_size; }
+const float& Organism::getSize()const { return field(OF::Size); }
 
 ////////////////////////////////////////////////////////////
-void Organism::setSize(const float& t_size) { m_trait_size = t_size; }
+void Organism::setSize(const float& t_size) { field(OF::Size) = t_size; }
 
 ////////////////////////////////////////////////////////////
 const std::string& Organism::getName()const { return m_name; }
@@ -108,67 +195,91 @@ const std::string& Organism::getName()const { return m_name; }
 void Organism::setName(const std::string& t_name) { m_name = t_name; }
 
 ////////////////////////////////////////////////////////////
-void Organism::setEnergy(const float& t_energy) { m_energy = t_energy; }
+void Organism::setEnergy(const float& t_energy) { field(OF::Energy) = t_energy; }
 
 ////////////////////////////////////////////////////////////
-void Organism::addEnergy(const float& t_energy) { m_energy += t_energy; if (m_energy >= m_trait_maxEnergy) { m_energy = m_trait_maxEnergy; } }
+void Organism::addEnergy(const float& t_energy) {
+	auto& energy{ field(OF::Energy) };
+	energy += t_energy;
+	if (energy >= field(OF::MaxEnergy)) { energy = field(OF::MaxEnergy); }
+}
 
 ////////////////////////////////////////////////////////////
-const float& Organism::getEnergy()const { return m_energy; }
+const float& Organism::getEnergy()const { return field(OF::Energy); }
 
 ////////////////////////////////////////////////////////////
-const float& Organism::getMass()const { return m_mass; }
+const float& Organism::getMass()const { return field(OF::Mass); }
 
 ////////////////////////////////////////////////////////////
-const float Organism::getRestingMetabolicRate()const { return m_trait_restingMetabolicRate * m_mass; }
+const float& Organism::getFoodDetectionRange()const { return field(OF::FoodDetectionRange); }
 
 ////////////////////////////////////////////////////////////
-float Organism::getEnergyPct()const { return m_energy / m_trait_maxEnergy; }
+const float Organism::getRestingMetabolicRate()const { return field(OF::RestingMetabolicRate) * field(OF::Mass); }
+
+////////////////////////////////////////////////////////////
+float Organism::getEnergyPct()const { return field(OF::Energy) / field(OF::MaxEnergy); }
 
 ////////////////////////////////////////////////////////////
 void Organism::setEnergyPct(const float& t_pct) {
-	m_energy = m_trait_maxEnergy * t_pct;
-	if (m_energy > m_trait_maxEnergy) { m_energy = m_trait_maxEnergy; }
-	else if (m_energy < 0.f) { m_energy = 0.f; }
+	auto& energy{ field(OF::Energy) };
+	const auto& maxEnergy{ field(OF::MaxEnergy) };
+	energy = maxEnergy * t_pct;
+	if (energy > maxEnergy) { energy = maxEnergy; }
+	else if (energy < 0.f) { energy = 0.f; }
 }
 
 ////////////////////////////////////////////////////////////
 void Organism::addEnergyPct(const float& t_pct) {
-	m_energy += m_trait_maxEnergy * t_pct;
-	if (m_energy > m_trait_maxEnergy) { m_energy = m_trait_maxEnergy; }
-	else if (m_energy < 0.f) { m_energy = 0.f; }
+	auto& energy{ field(OF::Energy) };
+	const auto& maxEnergy{ field(OF::MaxEnergy) };
+	energy += maxEnergy * t_pct;
+	if (energy > maxEnergy) { energy = maxEnergy; }
+	else if (energy < 0.f) { energy = 0.f; }
+}
+
+////////////////////////////////////////////////////////////
+void Organism::setPosition(const sf::Vector2f& t_position) {
+	Actor_Base::setPosition(t_position);
+	field(OF::PositionX) = m_position.x;
+	field(OF::PositionY) = m_position.y;
+}
+
+////////////////////////////////////////////////////////////
+void Organism::setRotation(const float& t_rotation) {
+	Actor_Base::setRotation(t_rotation);
+	field(OF::Rotation) = m_rotation;
 }
 
 ////////////////////////////////////////////////////////////
 void Organism::move(const float& t_dx, const float& t_dy) {
-	float energyExpediture{ std::sqrtf(t_dx * t_dx + t_dy * t_dy) * m_mass };
-	m_energy -= energyExpediture; // Movement costs energy: diplacement * mass
+	float energyExpediture{ std::sqrt(t_dx * t_dx + t_dy * t_dy) * field(OF::Mass) };
+	field(OF::Energy) -= energyExpediture; // Movement costs energy: diplacement * mass
 	m_scenario->addEnergy(energyExpediture); // Return heat energy to environment
 	Actor_Base::move(t_dx, t_dy);
+	field(OF::PositionX) = m_position.x;
+	field(OF::PositionY) = m_position.y;
 }
 
 ////////////////////////////////////////////////////////////
 void Organism::rotate(const float& t_deg) {
-	float energyExpediture{ std::fabs(mat::toRadians(t_deg)) * m_mass };
-	m_energy -= energyExpediture;
+	float energyExpediture{ std::fabs(mat::toRadians(t_deg)) * field(OF::Mass) };
+	field(OF::Energy) -= energyExpediture;
 	m_scenario->addEnergy(energyExpediture); // Return heat energy to environment
 	Actor_Base::rotate(t_deg);
+	field(OF::Rotation) = m_rotation;
 }
 
 ////////////////////////////////////////////////////////////
 void Organism::update(const float& t_elapsed) {
-	// Update the organism's age
-	m_age += t_elapsed;
-
-
-	// Decrease the organism's energy based on its metabolic rate
-	float energyExpediture{ m_trait_restingMetabolicRate * t_elapsed };
-	m_energy -= energyExpediture;
-	m_scenario->addEnergy(energyExpediture); // Return heat energy to environment
-
-	if ((m_age >= m_trait_lifespan || m_energy <= 0.f) && !m_isDead) { die(); }
-	if (m_isDead) {
-		if (m_destructionDelay <= 0.f) { m_destroy = true; }
+	// Aging, metabolism and idle movement already ran for this tick in the engine's organism store
+
+	bool isDead{ m_store->isDead(m_slot) };
+	if ((field(OF::Age) >= field(OF::Lifespan) || field(OF::Energy) <= 0.f) && !isDead) { die(); isDead = true; }
+	if (isDead) {
+		if (m_destructionDelay <= 0.f) {
+			m_destroy = true;
+			m_store->setIsSpawned(m_slot, false); // Removed next tick; stop simulating it
+		}
 		m_destructionDelay -= t_elapsed;
 		return;
 	}// Dead organisms do not move, they just wait to decompose.
@@ -179,18 +290,6 @@ void Organism::update(const float& t_elapsed) {
 	// Update the organim's ai
 	m_ai->update(this, t_elapsed);
 
-#if defined(_DEBUG) && IS_DISPLAY_ORGNAISMS_DEBUG_TEXT == 1
-	setTextString(m_name +
-		"\nEnergy: " + std::to_string(static_cast<unsigned>(m_energy >= 0.f ? m_energy : 0.f)) + " / " + std::to_string(static_cast<unsigned>(m_trait_maxEnergy)) +
-		"\nAge   : " + std::to_string(static_cast<unsigned>(m_age)) + " / " + std::to_string(static_cast<unsigned>(m_trait_lifespan)) +
-		"\nSize  : " + std::to_string(m_trait_size) +
-		"\nMass  : " + std::to_string(m_mass) +
-		"\nRMR   : " + std::to_string(m_rmr) +
-		"\nMovSp : " + std::to_string(m_trait_movementSpeed) +
-		"\nRotSp : " + std::to_string(m_trait_turningSpeed) +
-		"\nDigEff: " + std::to_string(m_trait_digestiveEfficiency));
-#endif // defined(_DEBUG) && IS_DISPLAY_ORGNAISMS_DEBUG_TEXT == 1
-
 	// Lower level update (position, rotation ...)
 	Actor_Base::update(t_elapsed);
 
@@ -200,43 +299,44 @@ void Organism::update(const float& t_elapsed) {
 
 ////////////////////////////////////////////////////////////
 ActorPtr Organism::clone() {
-	auto o{ std::make_unique<Organism>(m_context, m_name, m_position, m_rotation, m_age) };
-	o->m_traits = std::move(*m_traits.clone().release()); // Pass unique ptr to regular member
+	auto o{ make(m_context, m_name, m_position, m_rotation, getAge()) };
+	o->m_traits = m_traits; // The genome is a flat copy
 	o->m_traits.onOrganismConstruction(o.get(), 0.f); // Update "OnConstruction" traits
 	return std::move(o);
 }
 
 ////////////////////////////////////////////////////////////
 ActorPtr Organism::reproduce(SharedContext& t_context) {
-	auto o{ std::make_unique<Organism>(m_context, m_name, m_position, m_rotation, 0.f) }; // Reset the organism's age
-	o->m_traits = std::move(*m_traits.reproduce(t_context).release());
+	auto o{ make(m_context, m_name, m_position, m_rotation, 0.f) }; // Reset the organism's age; no allocation once the pool has organisms
+	m_traits.reproduce(t_context, o->m_traits); // Written straight into the offspring
 	o->m_traits.onOrganismConstruction(o.get(), 0.f);
 	return std::move(o);
 }
 
 ////////////////////////////////////////////////////////////
 void Organism::die() {
-	m_isDead = true;
+	m_store->setIsDead(m_slot, true);
 	setColorRGB(S_DEATH_COLOR);
-	m_sprite.setColor(S_DEATH_COLOR);
-	m_name += " (dead)";
-	setTextString(m_name);
+	m_name += S_DEAD_SUFFIX;
+	setLabelText();
 }
 
 ////////////////////////////////////////////////////////////
 void Organism::eat(Food* t_food) {
 	if (!t_food || t_food->shouldBeDestroyed()) { return; } // Trying to eat ghost food doesn't work at this level of conciousness.
-	if (m_energy > 0.8f * m_trait_maxEnergy) { return; } // Ogranisms at and over 80% of energy are not experiencing hunger
+	auto& energy{ field(OF::Energy) };
+	const auto& maxEnergy{ field(OF::MaxEnergy) };
+	if (energy > s_hungerThreshold * maxEnergy) { return; } // Ogranisms at and over 80% of energy are not experiencing hunger
 
 	float foodEnergy{ t_food->getEnergy() };
-	float energyDelta{ foodEnergy * m_trait_digestiveEfficiency }; // Get the energy boost affected by digestive efficiency
+	float energyDelta{ foodEnergy * field(OF::DigestiveEfficiency) }; // Get the energy boost affected by digestive efficiency
 
-	m_energy += energyDelta;
+	energy += energyDelta;
 	m_scenario->addEnergy(foodEnergy - energyDelta); // Return the energy to the rest of the energy to the environment
 
-	if (m_energy > m_trait_maxEnergy) {
-		m_scenario->addEnergy(m_energy - m_trait_maxEnergy); // Return aswell any energy from overeating
-		m_energy = m_trait_maxEnergy;
+	if (energy > maxEnergy) {
+		m_scenario->addEnergy(energy - maxEnergy); // Return aswell any energy from overeating
+		energy = maxEnergy;
 	}
 	t_food->setWasEaten(true); // State that the food was eaten, so that it does not try to return its energy itelf, its the organism's task now.
 	t_food->setShouldBeDestroyed(true); // Tell the engine the food no longer exists (ha)
@@ -245,21 +345,65 @@ void Organism::eat(Food* t_food) {
 ////////////////////////////////////////////////////////////
 void Organism::updateCollider() {
 	auto aabb{ m_sprite.getLocalBounds() };
-	m_collider->update(this, m_position, { aabb.width * m_trait_size, aabb.height * m_trait_size });
+	const auto& size{ field(OF::Size) };
+	m_collider->update(this, m_position, { aabb.width * size, aabb.height * size });
 }
 
 ////////////////////////////////////////////////////////////
-float Organism::getRadius()const { return Actor_Base::getRadius() * m_trait_size; }
+float Organism::getRadius()const { return Actor_Base::getRadius() * field(OF::Size); }
+
+////////////////////////////////////////////////////////////
+float Organism::getScale()const { return field(OF::Size); }
+
+////////////////////////////////////////////////////////////
+void Organism::setLabelText() {
+#if defined(_DEBUG) && IS_DISPLAY_ORGNAISMS_DEBUG_TEXT == 1
+	static thread_local std::string s_text; // Reused, so births and deaths don't build a string each
+	s_text.assign(m_name).append(S_DEBUG_LABEL);
+	setTextString(s_text);
+#else
+	setTextString(m_name);
+#endif // defined(_DEBUG) && IS_DISPLAY_ORGNAISMS_DEBUG_TEXT == 1
+}
+
+////////////////////////////////////////////////////////////
+void Organism::updateLabel() {
+#if defined(_DEBUG) && IS_DISPLAY_ORGNAISMS_DEBUG_TEXT == 1
+	const float values[]{ std::max(getEnergy(), 0.f), field(OF::MaxEnergy), getAge(), field(OF::Lifespan), field(OF::Size), field(OF::Mass),
+		m_rmr, field(OF::MovementSpeed), field(OF::TurningSpeed), field(OF::DigestiveEfficiency) };
+	for (std::size_t i{ 0U }; i < sizeof(values) / sizeof(values[0]); i++) { m_label.setValue(i, values[i]); }
+#endif // defined(_DEBUG) && IS_DISPLAY_ORGNAISMS_DEBUG_TEXT == 1
+}
 
 ////////////////////////////////////////////////////////////
 bool Organism::canSpawn(SharedContext& t_context)const {
-	return m_scenario->getEnergy() >= m_energy; // Make sure there is enough energy in the environment for it to spawn
+	return m_scenario->getEnergy() >= getEnergy(); // Make sure there is enough energy in the environment for it to spawn
 }
 ////////////////////////////////////////////////////////////
-void Organism::onSpawn() {m_scenario->addEnergy(-m_energy); } // Capture energy from the environment
+void Organism::onSpawn() {m_scenario->addEnergy(-getEnergy()); } // Capture energy from the environment
+
+////////////////////////////////////////////////////////////
+void Organism::onSpawn(SharedContext& t_context) {
+	m_store->setIsSpawned(m_slot, true);
+	Actor_Base::onSpawn(t_context);
+}
 
 ////////////////////////////////////////////////////////////
 void Organism::onDestruction(SharedContext& t_context) {
-	m_scenario->addEnergy(m_energy); // Return the energy to the environment
+	m_scenario->addEnergy(getEnergy()); // Return the energy to the environment
 	Actor_Base::onDestruction(t_context);
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////
+void Organism::writeSnapshot(OrganismSnapshot& t_out_snapshot, TraitCollection& t_out_genome, std::string& t_out_names)const {
+	t_out_snapshot.m_position = m_position;
+	t_out_snapshot.m_rotation = m_rotation;
+	t_out_snapshot.m_color = m_color;
+	t_out_snapshot.m_destroy = m_destroy;
+	t_out_snapshot.m_slot = m_slot;
+	t_out_snapshot.m_destructionDelay = m_destructionDelay;
+	t_out_snapshot.m_nameOffset = static_cast<std::uint32_t>(t_out_names.size());
+	t_out_snapshot.m_nameLength = static_cast<std::uint32_t>(m_name.size());
+	t_out_names += m_name;
+	t_out_genome = m_traits;
+}
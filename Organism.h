@@ -14,47 +14,50 @@
 #include "TraitCollection.h"
 #include "Trait.h"
 #include "Collider.h"
+#include "OrganismStore.h"
 
 class Organism;
 class Food;
 class Scenario_Basic;
-
-using OrganismPtr = std::unique_ptr<Organism>;
+struct OrganismSnapshot;
 
 class Organism : public Actor_Base {
 	friend class Trait_Base;
+	friend class OrganismStore;
 
 protected:
 	HSL m_hslColor; // Contains the HSL copy of it's parent class RGB color for more better color manipulation
 
 	std::string m_name;
-	float m_age;
 
-	bool m_isDead;
 	float m_destructionDelay; // Time after death the organism's physical body remains after it has remerged with inifite conciousness
 
-	float m_energy; // Expended on every activity; Death when <= 0
-	float m_mass; // Energy expending body mass
 	float m_rmr; // Resting metabolic rate = mass * trait_based_rmr_coefficient
 
 	// ------------------------------ Traits ------------------------------
 	TraitCollection m_traits;
 
-	// ------------------------ Traits-based values -----------------------
-	float m_trait_maxEnergy;
-	float m_trait_digestiveEfficiency;
-	float m_trait_restingMetabolicRate;
-	float m_trait_movementSpeed;
-	float m_trait_turningSpeed;
-	float m_trait_foodDetectionRange;
-	float m_trait_lifespan;
-	float m_trait_size;
+	// -------------- Hot state (age, energy, mass, trait-based values) ---------------
+	OrganismStore* m_store; // Non-owning; the engine's structure of arrays
+	unsigned m_slot; // This organism's index in every column of the store
 
 	std::unique_ptr<Ai_Organism> m_ai;
 
 	Scenario_Basic* m_scenario; // Non-owning data ptr, used to return energy to the environment
 
 public:
+	static const float s_hungerThreshold; // Fraction of the max energy below which the organism eats and looks for food
+
+	static OrganismPtr make(SharedContext& t_context,
+		const std::string& t_name,
+		const sf::Vector2f& t_position,
+		const float& t_rotation,
+		const float& t_age); // Reuses a pooled organism if there is any, constructs one otherwise; traits are left to the caller
+
+	static OrganismPtr makeFromSnapshot(SharedContext& t_context,
+		const OrganismSnapshot& t_snapshot,
+		const TraitCollection& t_genome,
+		const std::string& t_name); // Its store fields are restored apart, with the whole store
 
 	static OrganismPtr makeDefaultClone(SharedContext& t_context,
 		const std::string& t_name,
@@ -68,12 +71,15 @@ public:
 		const float& t_rotation,
 		const float& t_age); // Makes an organism with traits reproduced from the default traits
 
+	static OrganismPtr makePooled(SharedContext& t_context); // Constructed straight into the store's pool: no slot, no name and nothing drawn from the rng
+
 
 	Organism(SharedContext& t_context,
 		const std::string& t_name,
 		const sf::Vector2f& t_position,
 		const float& t_rotation,
 		const float& t_age = 0.f);
+	~Organism();
 	const HSL& getColorHSL()const;
 	void setColorHSL(const float& t_h, const float& t_s, const float& t_l); // Also overwrites the SFML rgb color
 	const sf::Color& getColorRGB()const;
@@ -92,11 +98,14 @@ public:
 	void setEnergy(const float& t_energy);
 	void addEnergy(const float& t_energy);
 	const float& getMass()const;
+	const float& getFoodDetectionRange()const;
 	const float getRestingMetabolicRate()const;
 	float getEnergyPct()const;
 	void setEnergyPct(const float& t_pct);
 	void addEnergyPct(const float& t_pct);
 
+	void setPosition(const sf::Vector2f& t_position);
+	void setRotation(const float& t_rotation);
 	void move(const float& t_dx, const float& t_dy); // Decrease in internal energy
 	void rotate(const float& t_deg); // Decrease in internal energy
 
@@ -111,9 +120,24 @@ public:
 	void die();
 
 	float getRadius()const;
+	float getScale()const;
 
 	bool canSpawn(SharedContext& t_context)const;
 	void onSpawn();
+	void onSpawn(SharedContext& t_context); // Starts being simulated by the organism store
 	void onDestruction(SharedContext& t_context); // Return the energy to the environment
+
+	void writeSnapshot(OrganismSnapshot& t_out_snapshot, TraitCollection& t_out_genome, std::string& t_out_names)const; // Appends its name to the name table
+
+protected:
+	void updateLabel();
+
+private:
+	Organism(SharedContext& t_context); // Pooled, see makePooled()
+	void setLabelText(); // The name, and the debug fields if shown
+	void reinitialize(const std::string& t_name, const sf::Vector2f& t_position, const float& t_rotation, const float& t_age); // Brings a pooled organism back as a newborn
+	void initFields(const float& t_age);
+	float& field(const OrganismField& t_field);
+	const float& field(const OrganismField& t_field)const;
 };
 #endif // !ORGANISM_H
\ No newline at end of file
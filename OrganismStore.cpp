@@ -0,0 +1,242 @@
+#include "OrganismStore.h"
+#include <algorithm>
+#include <cmath>
+#include "Organism.h"
+#include "Scenario_Basic.h"
+#include "PerlinNoise.h"
+#include "MathHelpers.h"
+#include "Collider.h"
+
+using OF = OrganismField;
+
+////////////////////////////////////////////////////////////
+const unsigned OrganismStore::s_noSlot{ ~0U };
+
+////////////////////////////////////////////////////////////
+OrganismStore::OrganismStore() {}
+
+////////////////////////////////////////////////////////////
+OrganismStore::~OrganismStore() {} // Out of line, where the pooled organisms are a complete type
+
+////////////////////////////////////////////////////////////
+void OrganismStore::reserve(const std::size_t& t_numOrganisms) {
+	for (auto& column : m_columns) { column.reserve(t_numOrganisms); }
+	m_flags.reserve(t_numOrganisms);
+	m_owners.reserve(t_numOrganisms);
+	m_pool.reserve(t_numOrganisms);
+}
+
+////////////////////////////////////////////////////////////
+unsigned OrganismStore::allocate(Organism* t_owner) {
+	for (auto& column : m_columns) { column.emplace_back(0.f); }
+	m_flags.emplace_back(0U);
+	m_owners.emplace_back(t_owner);
+	return static_cast<unsigned>(m_owners.size() - 1U);
+}
+
+////////////////////////////////////////////////////////////
+void OrganismStore::release(const unsigned& t_slot) {
+	const unsigned last{ static_cast<unsigned>(m_owners.size() - 1U) };
+
+	// Move the last organism into the hole and tell it where it lives now
+	if (t_slot != last) {
+		for (auto& column : m_columns) { column[t_slot] = column[last]; }
+		m_flags[t_slot] = m_flags[last];
+		m_owners[t_slot] = m_owners[last];
+		m_owners[t_slot]->m_slot = t_slot;
+	}
+
+	for (auto& column : m_columns) { column.pop_back(); }
+	m_flags.pop_back();
+	m_owners.pop_back();
+}
+
+////////////////////////////////////////////////////////////
+std::size_t OrganismStore::size()const { return m_owners.size(); }
+
+////////////////////////////////////////////////////////////
+void OrganismStore::recycle(OrganismPtr t_organism) {
+	if (t_organism->m_slot != s_noSlot) {
+		release(t_organism->m_slot);
+		t_organism->m_slot = s_noSlot;
+	}
+	m_pool.emplace_back(std::move(t_organism));
+}
+
+////////////////////////////////////////////////////////////
+OrganismPtr OrganismStore::reuse() {
+	if (m_pool.empty()) { return nullptr; }
+	OrganismPtr organism{ std::move(m_pool.back()) };
+	m_pool.pop_back();
+	return organism;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t OrganismStore::getPoolSize()const { return m_pool.size(); }
+
+////////////////////////////////////////////////////////////
+std::uint64_t OrganismStore::getChecksum()const {
+	std::uint64_t hash{ 0xCBF29CE484222325ULL };
+	auto add{ [&hash](const void* t_data, const std::size_t& t_size) {
+		const auto* bytes{ static_cast<const unsigned char*>(t_data) };
+		for (std::size_t i{ 0U }; i < t_size; i++) { hash = (hash ^ bytes[i]) * 0x100000001B3ULL; }
+	} };
+	for (const auto& column : m_columns) { add(column.data(), column.size() * sizeof(float)); }
+	add(m_flags.data(), m_flags.size());
+	return hash;
+}
+
+////////////////////////////////////////////////////////////
+float& OrganismStore::get(const OrganismField& t_field, const unsigned& t_slot) { return m_columns[static_cast<std::size_t>(t_field)][t_slot]; }
+
+////////////////////////////////////////////////////////////
+const float& OrganismStore::get(const OrganismField& t_field, const unsigned& t_slot)const { return m_columns[static_cast<std::size_t>(t_field)][t_slot]; }
+
+////////////////////////////////////////////////////////////
+OrganismColumn& OrganismStore::getColumn(const OrganismField& t_field) { return m_columns[static_cast<std::size_t>(t_field)]; }
+
+////////////////////////////////////////////////////////////
+const OrganismColumn& OrganismStore::getColumn(const OrganismField& t_field)const { return m_columns[static_cast<std::size_t>(t_field)]; }
+
+////////////////////////////////////////////////////////////
+const OrganismColumns& OrganismStore::getColumns()const { return m_columns; }
+
+////////////////////////////////////////////////////////////
+const std::vector<std::uint8_t>& OrganismStore::getFlags()const { return m_flags; }
+
+////////////////////////////////////////////////////////////
+const std::vector<Organism*>& OrganismStore::getOwners()const { return m_owners; }
+
+////////////////////////////////////////////////////////////
+bool OrganismStore::restore(const OrganismColumnData& t_columns, const std::uint8_t* t_flags, const std::vector<Organism*>& t_owners) {
+	if (t_owners.size() != m_owners.size()) { return false; }
+
+	const std::size_t numRows{ m_owners.size() };
+	for (std::size_t i{ 0U }; i < m_columns.size(); i++) { m_columns[i].assign(t_columns[i], t_columns[i] + numRows); } // Same sizes: copies into the memory already there
+	m_flags.assign(t_flags, t_flags + numRows);
+	m_owners = t_owners;
+	for (unsigned i{ 0U }; i < m_owners.size(); i++) { m_owners[i]->m_slot = i; }
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool OrganismStore::isSpawned(const unsigned& t_slot)const { return m_flags[t_slot] & FLAG_SPAWNED; }
+
+////////////////////////////////////////////////////////////
+void OrganismStore::setIsSpawned(const unsigned& t_slot, bool t_isSpawned) {
+	if (t_isSpawned) { m_flags[t_slot] |= FLAG_SPAWNED; }
+	else { m_flags[t_slot] &= ~FLAG_SPAWNED; }
+}
+
+////////////////////////////////////////////////////////////
+bool OrganismStore::isDead(const unsigned& t_slot)const { return m_flags[t_slot] & FLAG_DEAD; }
+
+////////////////////////////////////////////////////////////
+void OrganismStore::setIsDead(const unsigned& t_slot, bool t_isDead) {
+	if (t_isDead) { m_flags[t_slot] |= FLAG_DEAD; }
+	else { m_flags[t_slot] &= ~FLAG_DEAD; }
+}
+
+////////////////////////////////////////////////////////////
+void OrganismStore::senseFood(const BroadPhase_Base& t_broadPhase) {
+	const std::size_t n{ m_owners.size() };
+	std::uint8_t* flags{ m_flags.data() };
+	const float* x{ getColumn(OF::PositionX).data() };
+	const float* y{ getColumn(OF::PositionY).data() };
+	const float* energy{ getColumn(OF::Energy).data() };
+	const float* maxEnergy{ getColumn(OF::MaxEnergy).data() };
+	const float* range{ getColumn(OF::FoodDetectionRange).data() };
+	float* foodHeading{ getColumn(OF::FoodHeading).data() };
+
+	const auto& bounds{ t_broadPhase.getBounds() };
+	const sf::Vector2f worldSize{ bounds.width, bounds.height };
+
+	// One query per hungry organism; only sated, dead and unspawned ones are skipped
+	for (std::size_t i{ 0U }; i < n; i++) {
+		flags[i] &= ~FLAG_SEES_FOOD;
+		if ((flags[i] & (FLAG_SPAWNED | FLAG_DEAD)) != FLAG_SPAWNED) { continue; }
+		if (range[i] <= 0.f || energy[i] > Organism::s_hungerThreshold * maxEnergy[i]) { continue; }
+
+		const sf::Vector2f position{ x[i], y[i] };
+		const Collider* food{ t_broadPhase.getNearest(m_queryScratch, position, range[i], ActorType::Food) };
+		if (!food) { continue; }
+
+		const sf::Vector2f delta{ mat::toroidalDelta(position, food->getCenterPos(), worldSize) };
+		foodHeading[i] = mat::normalizeAngle(mat::toDegrees(std::atan2(delta.y, delta.x)));
+		flags[i] |= FLAG_SEES_FOOD;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void OrganismStore::update(const float& t_elapsed, Scenario_Basic& t_scenario, const BroadPhase_Base& t_broadPhase) {
+	senseFood(t_broadPhase);
+
+	const std::size_t n{ m_owners.size() };
+	const std::uint8_t* flags{ m_flags.data() };
+	float* x{ getColumn(OF::PositionX).data() };
+	float* y{ getColumn(OF::PositionY).data() };
+	float* rotation{ getColumn(OF::Rotation).data() };
+	float* energy{ getColumn(OF::Energy).data() };
+	float* age{ getColumn(OF::Age).data() };
+	const float* mass{ getColumn(OF::Mass).data() };
+	const float* rmr{ getColumn(OF::RestingMetabolicRate).data() };
+	const float* movementSpeed{ getColumn(OF::MovementSpeed).data() };
+	const float* turningSpeed{ getColumn(OF::TurningSpeed).data() };
+	const float* lifespan{ getColumn(OF::Lifespan).data() };
+	const float* noiseOffset{ getColumn(OF::NoiseOffset).data() };
+	const float* foodHeading{ getColumn(OF::FoodHeading).data() };
+
+	float heat{ 0.f }; // Energy returned to the environment, handed back once at the end
+
+	// Aging and resting metabolism (dead organisms keep decomposing)
+	for (std::size_t i{ 0U }; i < n; i++) {
+		if (!(flags[i] & FLAG_SPAWNED)) { continue; }
+		age[i] += t_elapsed;
+		const float energyExpediture{ rmr[i] * t_elapsed };
+		energy[i] -= energyExpediture;
+		heat += energyExpediture;
+	}
+
+	// Movement; organisms that are dead or about to die this tick don't move
+	for (std::size_t i{ 0U }; i < n; i++) {
+		if ((flags[i] & (FLAG_SPAWNED | FLAG_DEAD)) != FLAG_SPAWNED) { continue; }
+		if (age[i] >= lifespan[i] || energy[i] <= 0.f) { continue; }
+
+		// Turn toward the food in sight as fast as allowed, or wander with perlin noise for natural-looking movement
+		float turn{ 0.f };
+		float pace{ 1.f };
+		if (flags[i] & FLAG_SEES_FOOD) {
+			const float offset{ std::fmod(foodHeading[i] - rotation[i] + 540.f, 360.f) - 180.f }; // [-180 180)
+			const float maxTurn{ turningSpeed[i] * t_elapsed };
+			turn = std::max(-maxTurn, std::min(offset, maxTurn));
+			pace = std::max(0.f, std::cos(mat::toRadians(offset))); // Slow down while the food isn't ahead, so it isn't circled forever
+		}
+		else { turn = PerlinNoise::noise(noiseOffset[i] + age[i]) * turningSpeed[i] * t_elapsed; }
+
+		// Move forward: costs diplacement * mass
+		const float displacement{ movementSpeed[i] * pace * t_elapsed };
+		float dx{ 0.f };
+		float dy{ 0.f };
+		mat::to_cartesian(displacement, rotation[i], dx, dy);
+		x[i] += dx;
+		y[i] += dy;
+		const float movementExpediture{ std::fabs(displacement) * mass[i] };
+
+		// Turning costs radians * mass
+		rotation[i] = mat::normalizeAngle(rotation[i] + turn);
+		const float turningExpediture{ std::fabs(mat::toRadians(turn)) * mass[i] };
+
+		energy[i] -= movementExpediture + turningExpediture;
+		heat += movementExpediture + turningExpediture;
+	}
+
+	t_scenario.addEnergy(heat); // Return heat energy to environment
+
+	// Hand the new transforms to the actors
+	for (std::size_t i{ 0U }; i < n; i++) {
+		if (!(flags[i] & FLAG_SPAWNED)) { continue; }
+		m_owners[i]->m_position.x = x[i];
+		m_owners[i]->m_position.y = y[i];
+		m_owners[i]->m_rotation = rotation[i];
+	}
+}
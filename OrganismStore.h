@@ -0,0 +1,97 @@
+#ifndef ORGANISM_STORE_H
+#define ORGANISM_STORE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BroadPhase_Base.h"
+
+class Organism;
+class Scenario_Basic;
+
+enum class OrganismField {
+	PositionX,
+	PositionY,
+	Rotation,				// [0 360)
+	Energy,					// Expended on every activity; Death when <= 0
+	Mass,					// Energy expending body mass
+	Age,
+	MaxEnergy,
+	DigestiveEfficiency,
+	RestingMetabolicRate,
+	MovementSpeed,
+	TurningSpeed,
+	FoodDetectionRange,
+	Lifespan,
+	Size,
+	NoiseOffset,			// Offset into the perlin noise used for the idle movement
+	FoodHeading,			// [0 360) Direction of the nearest food in range, when the organism sees any
+	FIELD_COUNT
+};
+
+using OrganismPtr = std::unique_ptr<Organism>;
+using OrganismColumn = std::vector<float>;
+using OrganismColumns = std::array<OrganismColumn, static_cast<std::size_t>(OrganismField::FIELD_COUNT)>;
+using OrganismColumnData = std::array<const float*, static_cast<std::size_t>(OrganismField::FIELD_COUNT)>; // Columns held elsewhere, e.g. in a mapped file
+
+// Structure of arrays with the hot state of every organism, so that aging, metabolism and movement
+//	run as tight loops over contiguous memory. Sprites, text, names and traits stay in the organisms.
+//	Every organism owns a slot for its whole life; released slots are filled with the last one to keep the arrays dense.
+//	Destroyed organisms are parked in a pool, sprite, text and collider included, so births reuse them instead of allocating.
+class OrganismStore {
+
+	enum OrganismFlags : std::uint8_t {
+		FLAG_SPAWNED = 1 << 0, // Only spawned organisms are simulated (not templates nor queued offspring)
+		FLAG_DEAD = 1 << 1,
+		FLAG_SEES_FOOD = 1 << 2
+	};
+
+	OrganismColumns m_columns;
+	std::vector<std::uint8_t> m_flags;
+	std::vector<Organism*> m_owners;
+	std::vector<OrganismPtr> m_pool; // Recycled organisms, without a slot
+	RangeQueryScratch m_queryScratch; // Reused by every food query
+
+	OrganismStore(const OrganismStore& t_rhs) = delete;
+
+public:
+	static const unsigned s_noSlot; // Slot of the organisms waiting in the pool
+
+	OrganismStore();
+	~OrganismStore();
+	void reserve(const std::size_t& t_numOrganisms); // Makes room for that many organisms, alive or pooled, before any birth has to grow the arrays
+	unsigned allocate(Organism* t_owner); // Returns the slot of the new organism; all its fields start at 0
+	void release(const unsigned& t_slot);
+	std::size_t size()const;
+
+	void recycle(OrganismPtr t_organism); // Releases the slot of a destroyed organism, if it has one, and keeps it for reuse
+	OrganismPtr reuse(); // The last recycled organism, without a slot; nullptr if the pool is empty
+	std::size_t getPoolSize()const;
+	std::uint64_t getChecksum()const; // FNV-1a of every field and flag of the live organisms, in slot order
+
+	float& get(const OrganismField& t_field, const unsigned& t_slot);
+	const float& get(const OrganismField& t_field, const unsigned& t_slot)const;
+	OrganismColumn& getColumn(const OrganismField& t_field);
+	const OrganismColumn& getColumn(const OrganismField& t_field)const;
+
+	const OrganismColumns& getColumns()const;
+	const std::vector<std::uint8_t>& getFlags()const;
+	const std::vector<Organism*>& getOwners()const;
+	// Overwrites every row with the given columns and flags, one bulk copy each, and hands row i to t_owners[i];
+	//	the owners must be exactly the organisms holding a slot now, in any order (used to load snapshots)
+	bool restore(const OrganismColumnData& t_columns, const std::uint8_t* t_flags, const std::vector<Organism*>& t_owners);
+
+	bool isSpawned(const unsigned& t_slot)const;
+	void setIsSpawned(const unsigned& t_slot, bool t_isSpawned);
+	bool isDead(const unsigned& t_slot)const;
+	void setIsDead(const unsigned& t_slot, bool t_isDead);
+
+	// Ages, metabolizes and moves every spawned organism; hungry ones steer toward the nearest food in the broad phase
+	void update(const float& t_elapsed, Scenario_Basic& t_scenario, const BroadPhase_Base& t_broadPhase);
+
+private:
+	void senseFood(const BroadPhase_Base& t_broadPhase);
+};
+
+#endif // !ORGANISM_STORE_H
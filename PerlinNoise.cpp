@@ -1,6 +1,7 @@
 #include "PerlinNoise.h"
-#include <random>
+#include <algorithm>
 #include <cmath>
+#include "RandomGenerator.h"
 
 ////////////////////////////////////////////////////////////
 static int32_t fastfloor(float t_fp) {
@@ -60,14 +61,19 @@ uint8_t PerlinNoise::s_perm[256]{
 
 
 ////////////////////////////////////////////////////////////
-void PerlinNoise::resetPermutationList(unsigned t_seed) {
-	std::mt19937 engine{ t_seed };
-	std::uniform_int_distribution<int> rng{ 0,255 };
+void PerlinNoise::resetPermutationList(const std::uint64_t& t_seed) {
+	RandomGenerator rng{ t_seed }; // Same table on every platform, unlike the std distributions
 	for (unsigned i{ 0U }; i < 256U; i++) {
-		s_perm[i] = rng(engine);
+		s_perm[i] = static_cast<uint8_t>(rng.generate(0, 255));
 	}
 }
 
+////////////////////////////////////////////////////////////
+const uint8_t* PerlinNoise::getPermutationList() { return s_perm; }
+
+////////////////////////////////////////////////////////////
+void PerlinNoise::setPermutationList(const uint8_t* t_perm) { std::copy(t_perm, t_perm + 256, s_perm); }
+
 ////////////////////////////////////////////////////////////
 float PerlinNoise::noise(float t_x) {
 	float n0, n1;
@@ -14,7 +14,9 @@ public:
 	static float noise(float t_x, float t_y);
 	static float noise(float t_x, float t_y, float t_z);
 
-	static void resetPermutationList(unsigned t_seed);
+	static void resetPermutationList(const std::uint64_t& t_seed);
+	static const uint8_t* getPermutationList(); // 256 entries
+	static void setPermutationList(const uint8_t* t_perm);
 
 };
 
@@ -4,8 +4,12 @@
 #define IS_PRINT_TRIGGERED_ACTIONS_TO_CONSOLE 0 // When in debug mode, this value causes the action definitions of the engine to print their result to the console
 #define IS_DISPLAY_ACTOR_TAGS 1
 #define IS_DISPLAY_ORGNAISMS_DEBUG_TEXT 1 // Display energy, resting metabolic rate, mass and size of the organisms on their nametags 
-#define IS_DRAW_COLLISION_QUADTREE 1 
+#define IS_DRAW_COLLISION_BROAD_PHASE 1 
 #define IS_DRAW_ACTOR_AABB 1
 #define IS_DEBUG_OBJECTS 1
+#ifndef IS_COUNT_ALLOCATIONS
+#define IS_COUNT_ALLOCATIONS 0 // 1 counts the calls to the global operator new for the benchmarks; the genesia_benchmark target defines it
+#endif // !IS_COUNT_ALLOCATIONS
+#define IS_PROFILE_FRAMES 1 // Times the engine phases into rolling percentiles (overlay and --profile dump); 0 compiles every timer out
 
 #endif // !GENESIA_PREPROCESSOR_DIRECTIVES_H
\ No newline at end of file
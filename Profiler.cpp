@@ -0,0 +1,96 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+////////////////////////////////////////////////////////////
+const std::size_t Profiler::s_windowSize{ 256U };
+
+static const std::array<const char*, static_cast<std::size_t>(ProfilePhase::PHASE_COUNT)> S_PHASE_NAMES{
+	"frame", "events", "tick", "spawn", "organisms", "actors", "scenario",
+	"collision", "broad_phase", "pairs", "resolve", "render" };
+static const std::array<unsigned, static_cast<std::size_t>(ProfilePhase::PHASE_COUNT)> S_PHASE_DEPTHS{ 0, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3, 1 }; // In the overlay
+
+////////////////////////////////////////////////////////////
+Profiler::Profiler() {
+	for (auto& phase : m_phases) { phase.m_samples.reserve(s_windowSize); }
+	m_scratch.reserve(s_windowSize);
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::record(const ProfilePhase& t_phase, const float& t_microseconds) {
+	PhaseSamples& phase{ m_phases[static_cast<std::size_t>(t_phase)] };
+	if (phase.m_samples.size() < s_windowSize) { phase.m_samples.push_back(t_microseconds); }
+	else { phase.m_samples[phase.m_next] = t_microseconds; }
+	phase.m_next = (phase.m_next + 1U) % s_windowSize;
+	phase.m_total++;
+}
+
+////////////////////////////////////////////////////////////
+ProfileStats Profiler::getStats(const ProfilePhase& t_phase)const {
+	ProfileStats stats;
+	const PhaseSamples& phase{ m_phases[static_cast<std::size_t>(t_phase)] };
+	if (phase.m_samples.empty()) { return stats; }
+
+	m_scratch = phase.m_samples;
+	std::sort(m_scratch.begin(), m_scratch.end()); // A few hundred floats, a few times per second
+	stats.m_count = m_scratch.size();
+	for (const auto& sample : m_scratch) { stats.m_mean += sample; }
+	stats.m_mean /= static_cast<float>(stats.m_count);
+	stats.m_p50 = m_scratch[(stats.m_count - 1U) / 2U];
+	stats.m_p99 = m_scratch[(stats.m_count - 1U) * 99U / 100U];
+	stats.m_max = m_scratch.back();
+	return stats;
+}
+
+////////////////////////////////////////////////////////////
+const char* Profiler::getPhaseName(const ProfilePhase& t_phase) { return S_PHASE_NAMES[static_cast<std::size_t>(t_phase)]; }
+
+////////////////////////////////////////////////////////////
+std::string Profiler::getOverlayText()const {
+	std::ostringstream text;
+	text << std::fixed << std::setprecision(2) << "phase (ms)          p50     p99\n";
+	for (std::size_t i{ 0U }; i < m_phases.size(); i++) {
+		const ProfilePhase phase{ static_cast<ProfilePhase>(i) };
+		const ProfileStats stats{ getStats(phase) };
+		if (!stats.m_count) { continue; }
+		const std::string name{ std::string(S_PHASE_DEPTHS[i] * 2U, ' ') + getPhaseName(phase) };
+		text << std::left << std::setw(16) << name << std::right
+			<< std::setw(8) << stats.m_p50 * 0.001f << std::setw(8) << stats.m_p99 * 0.001f << '\n';
+	}
+	return text.str();
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::dump(std::ostream& t_out)const {
+	t_out << "{\n\t\"window\": " << s_windowSize << ",\n\t\"unit\": \"us\",\n\t\"phases\": {";
+	bool isFirst{ true };
+	for (std::size_t i{ 0U }; i < m_phases.size(); i++) {
+		const ProfilePhase phase{ static_cast<ProfilePhase>(i) };
+		const ProfileStats stats{ getStats(phase) };
+		t_out << (isFirst ? "\n" : ",\n") << "\t\t\"" << getPhaseName(phase) << "\": { \"total\": " << m_phases[i].m_total
+			<< ", \"count\": " << stats.m_count << ", \"mean\": " << stats.m_mean << ", \"p50\": " << stats.m_p50
+			<< ", \"p99\": " << stats.m_p99 << ", \"max\": " << stats.m_max << " }";
+		isFirst = false;
+	}
+	t_out << "\n\t}\n}\n";
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::reset() {
+	for (auto& phase : m_phases) {
+		phase.m_samples.clear();
+		phase.m_next = 0U;
+		phase.m_total = 0U;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+ProfileScope::ProfileScope(Profiler& t_profiler, const ProfilePhase& t_phase) :
+	m_profiler{ t_profiler }, m_phase{ t_phase }, m_start{ std::chrono::steady_clock::now() } {}
+
+////////////////////////////////////////////////////////////
+ProfileScope::~ProfileScope() {
+	m_profiler.record(m_phase, std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - m_start).count());
+}
@@ -0,0 +1,77 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "PreprocessorDirectves.h"
+
+enum class ProfilePhase {
+	Frame,
+	Events,
+	Tick,					// One simulation step, made of the phases below
+	Spawn,
+	Organisms,				// Bulk update of the organism store
+	Actors,
+	Scenario,
+	Collision,				// Made of the three phases below
+	CollisionBroadPhase,	// Rebuild or relocation of the colliders
+	CollisionPairs,			// Candidate query and overlap test
+	CollisionResolve,
+	Render,
+	PHASE_COUNT
+};
+
+struct ProfileStats {
+	std::size_t m_count{ 0U }; // Samples in the window
+	float m_mean{ 0.f }; // Microseconds
+	float m_p50{ 0.f };
+	float m_p99{ 0.f };
+	float m_max{ 0.f };
+};
+
+// Rolling window of the last samples of every phase. Phases are timed on the main thread only.
+class Profiler {
+
+	static const std::size_t s_windowSize;
+
+	struct PhaseSamples {
+		std::vector<float> m_samples; // Ring buffer, microseconds
+		std::size_t m_next{ 0U };
+		unsigned long long m_total{ 0U }; // Samples ever recorded
+	};
+
+	std::array<PhaseSamples, static_cast<std::size_t>(ProfilePhase::PHASE_COUNT)> m_phases;
+	mutable std::vector<float> m_scratch; // Sorted copy of a window
+
+public:
+	Profiler();
+	void record(const ProfilePhase& t_phase, const float& t_microseconds);
+	ProfileStats getStats(const ProfilePhase& t_phase)const;
+	static const char* getPhaseName(const ProfilePhase& t_phase);
+	std::string getOverlayText()const; // One line per phase, nested phases indented
+	void dump(std::ostream& t_out)const; // JSON
+	void reset();
+};
+
+class ProfileScope { // Records the time until it goes out of scope
+	Profiler& m_profiler;
+	ProfilePhase m_phase;
+	std::chrono::steady_clock::time_point m_start;
+
+public:
+	ProfileScope(Profiler& t_profiler, const ProfilePhase& t_phase);
+	~ProfileScope();
+};
+
+#if IS_PROFILE_FRAMES == 1
+#define PROFILE_SCOPE_NAME(t_line) profileScope##t_line
+#define PROFILE_SCOPE_AT(t_profiler, t_phase, t_line) ProfileScope PROFILE_SCOPE_NAME(t_line){ t_profiler, t_phase }
+#define PROFILE_SCOPE(t_profiler, t_phase) PROFILE_SCOPE_AT(t_profiler, t_phase, __LINE__)
+#else
+#define PROFILE_SCOPE(t_profiler, t_phase)
+#endif // IS_PROFILE_FRAMES == 1
+
+#endif // !PROFILER_H
@@ -1,83 +1,105 @@
 #include "Quadtree.h"
+#include <algorithm>
 #include "Collider.h"
 #include "PreprocessorDirectves.h"
 const unsigned Quadtree::S_MAX_LEVELS{ 5U };
 const unsigned Quadtree::S_MAX_OBJECTS{ 5U };
+const unsigned Quadtree::S_MERGE_OBJECTS{ 2U }; // Well below S_MAX_OBJECTS so nodes don't split and merge back and forth
+const int Quadtree::S_ROOT{ 0 };
+const int Quadtree::NO_NODE{ -1 };
 
 
 ////////////////////////////////////////////////////////////
-Quadtree::Quadtree(const sf::FloatRect& t_bounds) : m_level{ 0U }, m_bounds{ t_bounds }{}
+Quadtree::Quadtree(const sf::FloatRect& t_bounds) {
+	m_nodes.emplace_back();
+	setNode(S_ROOT, t_bounds, 0U, NO_NODE);
+}
 
 ////////////////////////////////////////////////////////////
-Quadtree::Quadtree(const sf::FloatRect& t_bounds, const unsigned& t_level) : m_level{ t_level }, m_bounds{ t_bounds } {}
+const sf::FloatRect& Quadtree::getBounds()const { return m_nodes[S_ROOT].m_bounds; }
 
 ////////////////////////////////////////////////////////////
-const sf::FloatRect& Quadtree::getBounds()const { return m_bounds; }
+void Quadtree::insert(Collider* t_obj) { insertAt(S_ROOT, t_obj); }
 
 ////////////////////////////////////////////////////////////
-void Quadtree::insert(Collider* t_obj) {
-
-	if (m_nodes[0] != nullptr) {
-		int index{ getIndex(t_obj->getAABB()) };
-		if (index != THIS_TREE) {
-			m_nodes[index]->insert(t_obj);
-			return;
-		}
-	}
+void Quadtree::remove(Collider* t_obj) {
+	const int node{ slot(t_obj) };
+	if (node == NO_SLOT) { return; }
 
-	m_objects.push_back(t_obj);
+	auto& objects{ m_nodes[node].m_objects };
+	auto it{ std::find(objects.begin(), objects.end(), t_obj) };
+	*it = objects.back();
+	objects.pop_back();
+	slot(t_obj) = NO_SLOT;
 
-	if (m_objects.size() > S_MAX_OBJECTS&& m_level < S_MAX_LEVELS) {
-		if (m_nodes[0] == nullptr) {
-			split();
-		}
-
-		for (auto it{ m_objects.begin() }; it != m_objects.end();) {
-			auto obj{ *it };
-			int index{ getIndex(obj->getAABB()) };
-			if (index != THIS_TREE) {
-				m_nodes[index]->insert(obj);
-				it = m_objects.erase(it);
-			}
-			else { it++; }
-		}
+	// Fold back the highest ancestor that ran out of objects
+	int emptiest{ NO_NODE };
+	for (int n{ node }; n != NO_NODE; n = m_nodes[n].m_parent) {
+		m_nodes[n].m_count--;
+		if (m_nodes[n].m_firstChild != NO_NODE && m_nodes[n].m_count <= S_MERGE_OBJECTS) { emptiest = n; }
 	}
+	if (emptiest != NO_NODE) { merge(emptiest); }
 }
 
 ////////////////////////////////////////////////////////////
-void Quadtree::clear() {
-	m_objects.clear();
-	for (unsigned i{ 0U }; i < 4U; i++) {
-		if (m_nodes[i] != nullptr) {
-			m_nodes[i]->clear();
-			m_nodes[i] = nullptr;
-		}
+void Quadtree::relocate(Collider* t_obj) {
+	if (slot(t_obj) != NO_SLOT) {
+		if (belongsTo(slot(t_obj), t_obj->getAABB())) { return; } // Still in place
+		remove(t_obj);
 	}
+	insertAt(S_ROOT, t_obj);
 }
 
 ////////////////////////////////////////////////////////////
-void Quadtree::getPotentialOverlaps(Objects& t_out_objects, const Collider* t_obj)const {
-	getPotentialOverlaps(t_out_objects, t_obj->getAABB());
+void Quadtree::clear() {
+	for (auto& node : m_nodes) {
+		for (auto& obj : node.m_objects) { slot(obj) = NO_SLOT; }
+		node.m_objects.clear(); // Keeps the capacity
+	}
+	// Every block of four goes back to the pool, in order so they are handed out again as they were first allocated
+	m_freeBlocks.clear();
+	for (int first{ static_cast<int>(m_nodes.size()) - 4 }; first > S_ROOT; first -= 4) { m_freeBlocks.push_back(first); }
+	setNode(S_ROOT, getBounds(), 0U, NO_NODE);
 }
 
+////////////////////////////////////////////////////////////
 void Quadtree::getPotentialOverlaps(Objects& t_out_objects, const sf::FloatRect& t_aabb)const {
-	int index{ getIndex(t_aabb) };
-	if (index != THIS_TREE && m_nodes[0] != nullptr) {
-		m_nodes[index]->getPotentialOverlaps(t_out_objects, t_aabb);
+	sf::FloatRect pieces[4];
+	const unsigned numPieces{ wrapAABB(pieces, t_aabb, getBounds()) };
+	const std::size_t first{ t_out_objects.size() };
+	for (unsigned i{ 0U }; i < numPieces; i++) { collectOverlaps(t_out_objects, S_ROOT, pieces[i]); }
+
+	// The pieces of a wrapped aabb can reach the same nodes (the root at least)
+	if (numPieces > 1U) {
+		std::sort(t_out_objects.begin() + first, t_out_objects.end());
+		t_out_objects.erase(std::unique(t_out_objects.begin() + first, t_out_objects.end()), t_out_objects.end());
 	}
+}
 
-	t_out_objects.insert(t_out_objects.end(), m_objects.begin(), m_objects.end());
+////////////////////////////////////////////////////////////
+void Quadtree::getCandidatePairs(CandidatePairs& t_out_pairs)const {
+	Objects ancestors;
+	collectPairs(t_out_pairs, ancestors, S_ROOT);
+	collectWrappedPairs(t_out_pairs);
 }
 
 ////////////////////////////////////////////////////////////
-void Quadtree::setBounds(const sf::FloatRect& t_bounds) { m_bounds = t_bounds; }
+void Quadtree::setBounds(const sf::FloatRect& t_bounds) {
+	Objects objects;
+	for (auto& node : m_nodes) { objects.insert(objects.end(), node.m_objects.begin(), node.m_objects.end()); }
+
+	clear();
+	m_nodes[S_ROOT].m_bounds = t_bounds;
+	for (auto& obj : objects) { insertAt(S_ROOT, obj); }
+}
 
 
 ////////////////////////////////////////////////////////////
-int Quadtree::getIndex(const sf::FloatRect& t_aabbObj)const {
+int Quadtree::getIndex(const int& t_node, const sf::FloatRect& t_aabbObj)const {
+	const auto& bounds{ m_nodes[t_node].m_bounds };
 	int index{ -1 };
-	float vertMidPnt{ m_bounds.left + m_bounds.width * 0.5f };
-	float horiMidPnt{ m_bounds.top + m_bounds.height * 0.5f };
+	float vertMidPnt{ bounds.left + bounds.width * 0.5f };
+	float horiMidPnt{ bounds.top + bounds.height * 0.5f };
 
 	bool up{ t_aabbObj.top < horiMidPnt && (t_aabbObj.height + t_aabbObj.top < horiMidPnt) };
 	bool down{ t_aabbObj.top > horiMidPnt };
@@ -96,21 +118,183 @@ int Quadtree::getIndex(const sf::FloatRect& t_aabbObj)const {
 	return index;
 }
 
+////////////////////////////////////////////////////////////
+bool Quadtree::belongsTo(const int& t_node, const sf::FloatRect& t_aabbObj)const {
+	// Same node insert() would pick: inside the right quadrant all the way up, and not inside any of its own children
+	for (int n{ t_node }; m_nodes[n].m_parent != NO_NODE; n = m_nodes[n].m_parent) {
+		const int parent{ m_nodes[n].m_parent };
+		if (m_nodes[parent].m_firstChild + getIndex(parent, t_aabbObj) != n) { return false; }
+	}
+	return (m_nodes[t_node].m_firstChild == NO_NODE || getIndex(t_node, t_aabbObj) == THIS_TREE);
+}
+
+////////////////////////////////////////////////////////////
+void Quadtree::insertAt(const int& t_node, Collider* t_obj) {
+	m_nodes[t_node].m_count++;
+
+	if (m_nodes[t_node].m_firstChild != NO_NODE) {
+		int index{ getIndex(t_node, t_obj->getAABB()) };
+		if (index != THIS_TREE) {
+			insertAt(m_nodes[t_node].m_firstChild + index, t_obj);
+			return;
+		}
+	}
+
+	m_nodes[t_node].m_objects.push_back(t_obj);
+	slot(t_obj) = t_node;
+
+	if (m_nodes[t_node].m_objects.size() > S_MAX_OBJECTS && m_nodes[t_node].m_level < S_MAX_LEVELS) {
+		if (m_nodes[t_node].m_firstChild == NO_NODE) {
+			split(t_node);
+		}
+
+		// Push down whatever fits in a child (already counted in this node). Children may split and grow
+		//	the pool while doing so, so the objects are accessed by index instead of holding references.
+		std::size_t keep{ 0U };
+		for (std::size_t i{ 0U }; i < m_nodes[t_node].m_objects.size(); i++) {
+			auto obj{ m_nodes[t_node].m_objects[i] };
+			int index{ getIndex(t_node, obj->getAABB()) };
+			if (index != THIS_TREE) {
+				insertAt(m_nodes[t_node].m_firstChild + index, obj);
+			}
+			else { m_nodes[t_node].m_objects[keep++] = obj; }
+		}
+		m_nodes[t_node].m_objects.resize(keep);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Quadtree::split(const int& t_node) {
+	const int first{ allocateBlock() }; // May grow the pool: no node references are held across this call
+	const sf::FloatRect bounds{ m_nodes[t_node].m_bounds };
+	const unsigned level{ m_nodes[t_node].m_level + 1U };
+
+	float w{ bounds.width * 0.5f };
+	float h{ bounds.height * 0.5f };
+
+	setNode(first + CHILD_NE, sf::FloatRect(bounds.left + w, bounds.top, w, h), level, t_node);
+	setNode(first + CHILD_NW, sf::FloatRect(bounds.left, bounds.top, w, h), level, t_node);
+	setNode(first + CHILD_SW, sf::FloatRect(bounds.left, bounds.top + h, w, h), level, t_node);
+	setNode(first + CHILD_SE, sf::FloatRect(bounds.left + w, bounds.top + h, w, h), level, t_node);
+	m_nodes[t_node].m_firstChild = first;
+}
 
 ////////////////////////////////////////////////////////////
-void Quadtree::split() {
+void Quadtree::merge(const int& t_node) {
+	const int first{ m_nodes[t_node].m_firstChild };
+	if (first == NO_NODE) { return; }
 
-	float w{ m_bounds.width * 0.5f };
-	float h{ m_bounds.height * 0.5f };
+	for (int child{ first }; child < first + 4; child++) {
+		merge(child);
+		for (auto& obj : m_nodes[child].m_objects) {
+			slot(obj) = t_node;
+			m_nodes[t_node].m_objects.push_back(obj);
+		}
+		m_nodes[child].m_objects.clear();
+	}
+	m_nodes[t_node].m_firstChild = NO_NODE;
+	m_freeBlocks.push_back(first);
+}
+
+////////////////////////////////////////////////////////////
+void Quadtree::collectOverlaps(Objects& t_out_objects, const int& t_node, const sf::FloatRect& t_aabb)const {
+	const auto& node{ m_nodes[t_node] };
+	t_out_objects.insert(t_out_objects.end(), node.m_objects.begin(), node.m_objects.end());
+	if (node.m_firstChild == NO_NODE) { return; }
 
-	m_nodes[CHILD_NE] = std::make_unique<Quadtree>(sf::FloatRect(m_bounds.left + w, m_bounds.top, w, h), m_level + 1);
-	m_nodes[CHILD_NW] = std::make_unique<Quadtree>(sf::FloatRect(m_bounds.left, m_bounds.top, w, h), m_level + 1);
-	m_nodes[CHILD_SW] = std::make_unique<Quadtree>(sf::FloatRect(m_bounds.left, m_bounds.top + h, w, h), m_level + 1);
-	m_nodes[CHILD_SE] = std::make_unique<Quadtree>(sf::FloatRect(m_bounds.left + w, m_bounds.top + h, w, h), m_level + 1);
+	for (int child{ node.m_firstChild }; child < node.m_firstChild + 4; child++) {
+		if (m_nodes[child].m_count && m_nodes[child].m_bounds.intersects(t_aabb)) { collectOverlaps(t_out_objects, child, t_aabb); }
+	}
 }
 
+////////////////////////////////////////////////////////////
+void Quadtree::collectPairs(CandidatePairs& t_out_pairs, Objects& t_ancestors, const int& t_node)const {
+	// An object can only touch the ones in its own node and in the nodes along its path to the root
+	const auto& objects{ m_nodes[t_node].m_objects };
+	for (std::size_t i{ 0U }; i < objects.size(); i++) {
+		for (auto& ancestor : t_ancestors) {
+			if (ancestor->canInteract(objects[i])) { t_out_pairs.emplace_back(ancestor, objects[i]); }
+		}
+		for (std::size_t j{ i + 1U }; j < objects.size(); j++) {
+			if (objects[i]->canInteract(objects[j])) { t_out_pairs.emplace_back(objects[i], objects[j]); }
+		}
+	}
+
+	const int first{ m_nodes[t_node].m_firstChild };
+	if (first == NO_NODE) { return; }
+
+	t_ancestors.insert(t_ancestors.end(), objects.begin(), objects.end());
+	for (int child{ first }; child < first + 4; child++) { collectPairs(t_out_pairs, t_ancestors, child); }
+	t_ancestors.resize(t_ancestors.size() - objects.size());
+}
+
+////////////////////////////////////////////////////////////
+void Quadtree::collectWrappedPairs(CandidatePairs& t_out_pairs)const {
+	// The walk down the tree never pairs an object reaching past an edge with the ones by the opposite edge:
+	//	look those up with the pieces of its aabb that wrap back inside, as getPotentialOverlaps() does
+	const auto& bounds{ getBounds() };
+	CandidatePairs pairs;
+	Objects candidates;
+	sf::FloatRect pieces[4];
+	for (const auto& node : m_nodes) {
+		for (const auto& obj : node.m_objects) {
+			const auto aabb{ obj->getAABB() };
+			if (aabb.left >= bounds.left && aabb.top >= bounds.top &&
+				aabb.left + aabb.width <= bounds.left + bounds.width && aabb.top + aabb.height <= bounds.top + bounds.height) { continue; }
 
-#if defined(_DEBUG) &&  IS_DRAW_COLLISION_QUADTREE == 1
+			const unsigned numPieces{ wrapAABB(pieces, aabb, bounds) };
+			for (unsigned i{ 0U }; i < numPieces; i++) {
+				candidates.clear();
+				collectOverlaps(candidates, S_ROOT, pieces[i]);
+				for (const auto& other : candidates) {
+					// Objects along the same path to the root are paired by collectPairs() already
+					if (!obj->canInteract(other) || !pieces[i].intersects(other->getAABB())) { continue; }
+					if (isAncestorOrSelf(slot(obj), slot(other)) || isAncestorOrSelf(slot(other), slot(obj))) { continue; }
+					pairs.emplace_back(std::min(obj, other), std::max(obj, other));
+				}
+			}
+		}
+	}
+
+	// Both objects of a pair may reach past an edge, and several pieces may find the same object
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+	t_out_pairs.insert(t_out_pairs.end(), pairs.begin(), pairs.end());
+}
+
+////////////////////////////////////////////////////////////
+bool Quadtree::isAncestorOrSelf(const int& t_ancestor, int t_node)const {
+	for (; t_node != NO_NODE; t_node = m_nodes[t_node].m_parent) {
+		if (t_node == t_ancestor) { return true; }
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+int Quadtree::allocateBlock() {
+	if (!m_freeBlocks.empty()) {
+		const int first{ m_freeBlocks.back() };
+		m_freeBlocks.pop_back();
+		return first;
+	}
+	const int first{ static_cast<int>(m_nodes.size()) };
+	m_nodes.resize(m_nodes.size() + 4U);
+	return first;
+}
+
+////////////////////////////////////////////////////////////
+void Quadtree::setNode(const int& t_index, const sf::FloatRect& t_bounds, const unsigned& t_level, const int& t_parent) {
+	auto& node{ m_nodes[t_index] };
+	node.m_bounds = t_bounds;
+	node.m_objects.clear(); // Keeps the capacity of a recycled node
+	node.m_level = t_level;
+	node.m_parent = t_parent;
+	node.m_firstChild = NO_NODE;
+	node.m_count = 0U;
+}
+
+
+#if defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
 #include <SFML/Graphics/RectangleShape.hpp>
 
 static const sf::RectangleShape S_RECT_SHAPE{ []() {
@@ -121,26 +305,34 @@ static const sf::RectangleShape S_RECT_SHAPE{ []() {
 	return std::move(rect);
 }() };
 
-#endif // defined(_DEBUG) &&  IS_DRAW_COLLISION_QUADTREE == 1
+#endif // defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
+
 
+////////////////////////////////////////////////////////////
+void Quadtree::draw(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect) { drawNode(t_window, t_viewRect, S_ROOT); }
 
+#if defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
 ////////////////////////////////////////////////////////////
-void Quadtree::draw(sf::RenderWindow& t_window) {
-#if defined(_DEBUG) &&  IS_DRAW_COLLISION_QUADTREE == 1
-	
+void Quadtree::drawNode(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect, const int& t_node) {
+	const auto& node{ m_nodes[t_node] };
+	if (!node.m_bounds.intersects(t_viewRect)) { return; } // Neither it nor its children are in view
+
 	// Have children? Tell THEM to draw
-	if (m_nodes[0] != nullptr) {
-		for (auto& n : m_nodes) {
-			n->draw(t_window);
+	if (node.m_firstChild != NO_NODE) {
+		for (int child{ node.m_firstChild }; child < node.m_firstChild + 4; child++) {
+			drawNode(t_window, t_viewRect, child);
 		}
 	}
 	// Don't have children? Then you draw yourself
 	else {
 		auto rect{ S_RECT_SHAPE };
-		rect.setFillColor({0,0,255, static_cast<sf::Uint8>((255 * m_level)/S_MAX_LEVELS ) });
-		rect.setSize({ m_bounds.width, m_bounds.height });
-		rect.setPosition(m_bounds.left, m_bounds.top);
+		rect.setFillColor({0,0,255, static_cast<sf::Uint8>((255 * node.m_level)/S_MAX_LEVELS ) });
+		rect.setSize({ node.m_bounds.width, node.m_bounds.height });
+		rect.setPosition(node.m_bounds.left, node.m_bounds.top);
 		t_window.draw(rect);
 	}
-#endif // defined(_DEBUG) &&  IS_DRAW_COLLISION_QUADTREE == 1
 }
+#else
+////////////////////////////////////////////////////////////
+void Quadtree::drawNode(sf::RenderWindow&, const sf::FloatRect&, const int&) {}
+#endif // defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
@@ -1,21 +1,27 @@
 #ifndef QUADTREE_H
 #define QUADTREE_H
 
-#include <memory>
 #include <vector>
-#include <array>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include "BroadPhase_Base.h"
 
-class Quadtree;
 class Collider;
 
-using Nodes = std::array<std::unique_ptr<Quadtree>, 4U>;
-using Objects = std::vector<Collider*>;
-
+struct QuadtreeNode {
+	sf::FloatRect m_bounds;
+	Objects m_objects;
+	unsigned m_level;
+	int m_parent;
+	int m_firstChild; // The four children are contiguous in the pool; NO_NODE if this is a leaf
+	unsigned m_count; // Objects in this node and all of its descendants
+};
 
+using QuadtreeNodes = std::vector<QuadtreeNode>;
 
-class Quadtree {
+// Nodes live in a pooled, index-based array and are recycled four at a time, so the tree never allocates once warmed up.
+//	Colliders remember the node that holds them; relocate() moves only the ones whose aabb left that node.
+class Quadtree : public BroadPhase_Base {
 	enum {
 		THIS_TREE = -1,
 		CHILD_NE,
@@ -26,27 +32,43 @@ class Quadtree {
 
 	static const unsigned S_MAX_OBJECTS;
 	static const unsigned S_MAX_LEVELS;
+	static const unsigned S_MERGE_OBJECTS; // Children are folded back into their parent at or below this many objects
+	static const int S_ROOT;
+
+	QuadtreeNodes m_nodes;
+	std::vector<int> m_freeBlocks; // First index of each unused block of four nodes
+
+	static const int NO_NODE;
 
-	Nodes m_nodes;
-	Objects m_objects;
-	unsigned m_level;
-	sf::FloatRect m_bounds;
 public:
-	Quadtree(const sf::FloatRect& t_bounds); // Root constructor
-	Quadtree(const sf::FloatRect& t_bounds, const unsigned& t_level); // Child node constructor
+	using BroadPhase_Base::getPotentialOverlaps;
+
+	Quadtree(const sf::FloatRect& t_bounds);
 	const sf::FloatRect& getBounds()const;
 	void insert(Collider* t_obj);
-	void clear();
-	void getPotentialOverlaps(Objects& t_out_objects, const Collider* t_obj)const;
+	void remove(Collider* t_obj);
+	void relocate(Collider* t_obj); // Moves the object only if its aabb no longer belongs to its node
+	void clear(); // Empties the tree but keeps the node pool
 	void getPotentialOverlaps(Objects& t_out_objects, const sf::FloatRect& t_aabb)const;
-	void setBounds(const sf::FloatRect& t_bounds);
+	void getCandidatePairs(CandidatePairs& t_out_pairs)const; // Wraps around the edges of the world, like the grid
+	void setBounds(const sf::FloatRect& t_bounds); // Reinserts any objects already in the tree
 
-	void draw(sf::RenderWindow& t_window);
+	void draw(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect);
 
 
 private:
-	int getIndex(const sf::FloatRect& t_aabbObj)const;
-	void split();
+	int getIndex(const int& t_node, const sf::FloatRect& t_aabbObj)const;
+	bool belongsTo(const int& t_node, const sf::FloatRect& t_aabbObj)const;
+	void insertAt(const int& t_node, Collider* t_obj);
+	void split(const int& t_node);
+	void merge(const int& t_node); // Pulls the objects of every descendant into t_node and frees them
+	int allocateBlock();
+	void setNode(const int& t_index, const sf::FloatRect& t_bounds, const unsigned& t_level, const int& t_parent);
+	void collectOverlaps(Objects& t_out_objects, const int& t_node, const sf::FloatRect& t_aabb)const;
+	void collectPairs(CandidatePairs& t_out_pairs, Objects& t_ancestors, const int& t_node)const;
+	void collectWrappedPairs(CandidatePairs& t_out_pairs)const; // Pairs of objects reaching past the edges of the world
+	bool isAncestorOrSelf(const int& t_ancestor, int t_node)const;
+	void drawNode(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect, const int& t_node);
 
 };
 
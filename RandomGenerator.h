@@ -1,62 +1,89 @@
 #ifndef RANDOM_GENERATOR_H
 #define RANDOM_GENERATOR_H
 
+#include <cmath>
+#include <cstdint>
 #include <random>
-#include <SFML/System/Mutex.hpp>
-#include <SFML/System/Lock.hpp>
+#include <utility>
 
+// Counter-based generator: the n-th number of a stream is a pure function of (seed, stream, n), hashed with the
+//	splitmix64 finalizer. There is no shared state to lock nor distribution objects to rebuild, and any number of
+//	independent streams (per thread, per job chunk, per actor) come out of a single master seed.
+//	A generator is not meant to be shared between threads; hand each one its own stream instead.
 class RandomGenerator {
 
-	std::random_device m_device;
-	std::mt19937 m_engine;
-	std::normal_distribution<float> m_normalDistribution;
-	std::uniform_int_distribution<int> m_intDistribution;
-	std::uniform_real_distribution<float> m_floatDistribution;
-	sf::Mutex m_mutex;
+	std::uint64_t m_seed;
+	std::uint64_t m_stream;
+	std::uint64_t m_key;		// Seed and stream mixed together
+	std::uint64_t m_counter;	// Numbers drawn so far
+
+	static constexpr std::uint64_t S_GOLDEN_GAMMA{ 0x9E3779B97F4A7C15ULL };
+	static constexpr float S_TWO_PI{ 6.28318530718f };
+	static constexpr float S_24_BIT_UNIT{ 1.f / 16777216.f }; // 2^-24: floats have 24 bits of precision
 
 public:
 	////////////////////////////////////////////////////////////
-	RandomGenerator() : m_engine(m_device()) {}
-
+	explicit RandomGenerator(const std::uint64_t& t_seed = makeSeed(), const std::uint64_t& t_stream = 0U) :
+		m_seed{ t_seed }, m_stream{ t_stream }, m_key{ mix(t_seed ^ mix(t_stream + S_GOLDEN_GAMMA)) }, m_counter{ 0U } {}
 
 	////////////////////////////////////////////////////////////
-	float normalDisttribution(const float& t_mean, const float& t_stdDev) {
-		sf::Lock lock{ m_mutex };
-		if (t_mean != m_normalDistribution.mean() || t_stdDev != m_normalDistribution.stddev()) {
-			m_normalDistribution = std::normal_distribution<float>(t_mean,t_stdDev);
-		}
-		return m_normalDistribution(m_engine);
+	static std::uint64_t makeSeed() { // Non deterministic
+		std::random_device device;
+		return (static_cast<std::uint64_t>(device()) << 32) ^ device();
 	}
 
 	////////////////////////////////////////////////////////////
-	int generate(int t_min, int t_max) {
-		sf::Lock lock{ m_mutex };
+	static std::uint64_t mix(std::uint64_t t_x) { // splitmix64 finalizer
+		t_x = (t_x ^ (t_x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		t_x = (t_x ^ (t_x >> 27)) * 0x94D049BB133111EBULL;
+		return t_x ^ (t_x >> 31);
+	}
 
-		if (t_min > t_max) { std::swap(t_min, t_max); };
+	////////////////////////////////////////////////////////////
+	const std::uint64_t& getSeed()const { return m_seed; }
 
-		if (t_min != m_intDistribution.min() || t_max != m_intDistribution.max()) {
-			m_intDistribution = std::uniform_int_distribution<int>(t_min, t_max);
-		}
+	////////////////////////////////////////////////////////////
+	void setSeed(const std::uint64_t& t_seed) { *this = RandomGenerator(t_seed, m_stream); } // Restarts the stream
 
-		return m_intDistribution(m_engine);
-	}
+	////////////////////////////////////////////////////////////
+	const std::uint64_t& getCounter()const { return m_counter; }
 
 	////////////////////////////////////////////////////////////
-	int operator()(int t_min, int t_max) { return generate(t_min, t_max); }
+	void setCounter(const std::uint64_t& t_counter) { m_counter = t_counter; } // Jumps anywhere in the stream, e.g. where a snapshot left it
 
+	////////////////////////////////////////////////////////////
+	RandomGenerator getStream(const std::uint64_t& t_stream)const { return RandomGenerator(m_seed, t_stream); } // Independent of how far this one has been drawn
 
+	////////////////////////////////////////////////////////////
+	std::uint64_t next() { return mix(m_key + (++m_counter) * S_GOLDEN_GAMMA); }
 
 	////////////////////////////////////////////////////////////
-	float generate(float t_min, float t_max) {
-		sf::Lock lock{ m_mutex };
+	float normalDisttribution(const float& t_mean, const float& t_stdDev) {
+		// Box-Muller with both uniforms taken from a single draw; the sine half is dropped so no state is carried
+		const std::uint64_t bits{ next() };
+		const float u1{ (static_cast<float>(bits >> 40) + 1.f) * S_24_BIT_UNIT }; // (0 1]
+		const float u2{ static_cast<float>((bits >> 8) & 0xFFFFFFULL) * S_24_BIT_UNIT }; // [0 1)
+		return t_mean + t_stdDev * std::sqrt(-2.f * std::log(u1)) * std::cos(S_TWO_PI * u2);
+	}
 
+	////////////////////////////////////////////////////////////
+	int generate(int t_min, int t_max) { // [min max]
 		if (t_min > t_max) { std::swap(t_min, t_max); };
+		const std::uint64_t range{ static_cast<std::uint64_t>(static_cast<std::int64_t>(t_max) - t_min) + 1U };
+		const std::uint64_t bits{ next() >> 32 };
+		return static_cast<int>(t_min + static_cast<std::int64_t>((bits * range) >> 32)); // Multiply-shift instead of a modulo
+	}
+
+	////////////////////////////////////////////////////////////
+	int operator()(int t_min, int t_max) { return generate(t_min, t_max); }
+
 
-		if (t_min != m_floatDistribution.min() || t_max != m_floatDistribution.max()) {
-			m_floatDistribution = std::uniform_real_distribution<float>(t_min, t_max);
-		}
 
-		return m_floatDistribution(m_engine);
+	////////////////////////////////////////////////////////////
+	float generate(float t_min, float t_max) { // [min max)
+		if (t_min > t_max) { std::swap(t_min, t_max); };
+		const float unit{ static_cast<float>(next() >> 40) * S_24_BIT_UNIT };
+		return t_min + unit * (t_max - t_min);
 	}
 
 
@@ -65,4 +92,4 @@ public:
 
 };
 
-#endif // !RANDOM_GENERATOR_H
\ No newline at end of file
+#endif // !RANDOM_GENERATOR_H
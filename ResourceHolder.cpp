@@ -1,7 +1,8 @@
 #include "ResourceHolder.h"
+#include "JobSystem.h"
 #include "Utilities.h"
 
-static const std::string S_RESOURCE_DIR{ "\\resources\\" };
+static const std::string S_RESOURCE_DIR{ "resources/" }; // Relative to the working directory, which ends with a separator; Windows takes / too
 
 ////////////////////////////////////////////////////////////
 const ResourceTypeStrings ResourceHolder::s_resourceTypeStrings{
@@ -25,25 +26,86 @@ ResourceType ResourceHolder::resourceTypeStrToId(const std::string& t_str) {
 }
 
 ////////////////////////////////////////////////////////////
-ResourceHolder::ResourceHolder() : m_workingDirPath{ utilities::getWorkingDirectory() }, m_mutex{}{}
+ResourceHolder::ResourceHolder(bool t_isHeadless) : m_workingDirPath{ utilities::getWorkingDirectory() }, m_isHeadless{ t_isHeadless }, m_mutex{},
+	m_isDecoding{ false } {}
 
 ////////////////////////////////////////////////////////////
-void ResourceHolder::init() {
-	sf::Lock lock{ m_mutex };
+ResourceHolder::~ResourceHolder() {
+	if (m_loader.joinable()) { m_loader.join(); }
+}
+
+////////////////////////////////////////////////////////////
+void ResourceHolder::init(JobSystem& t_jobSystem) {
+	if (m_loader.joinable()) { waitForLoading(); } // One loading at a time
 	std::string fullPath{ m_workingDirPath + S_RESOURCE_DIR };
 	auto resourceFilenames{ utilities::getFileList(fullPath) };
+	if (resourceFilenames.empty()) { std::cout << "! WARNING: No resources found in \"" << fullPath << '\"' << std::endl; }
 
-	
+	std::vector<std::pair<ResourceType, std::string>> files;
 	for (auto& it : resourceFilenames) {
 		const auto& fileName{ it.first };
 		std::string resType{ fileName.substr(0,fileName.find('_')) };
 		auto resTypeId{ resourceTypeStrToId(resType) };
 		if (resTypeId == ResourceType::INVALID_RESOURCE_TYPE) { continue; }
-		std::string nameNoExt{ fileName.substr(0,fileName.find_last_of('.')) };
-		loadResource(resTypeId, nameNoExt, fullPath + fileName);
+		files.emplace_back(resTypeId, fileName);
+	}
+
+	// A file per job; the loader thread only waits on them, so the window keeps running meanwhile
+	m_isDecoding = true;
+	m_loader = std::thread([this, &t_jobSystem, fullPath, files = std::move(files)]() {
+		t_jobSystem.parallelFor(files.size(), 1U, [this, &fullPath, &files](const std::size_t& t_begin, const std::size_t& t_end, const std::size_t&) {
+			for (std::size_t i{ t_begin }; i < t_end; i++) {
+				const auto& fileName{ files[i].second };
+				LoadedResource loaded{ decodeResource(files[i].first, fileName.substr(0, fileName.find_last_of('.')), fullPath + fileName) };
+				sf::Lock lock{ m_mutex };
+				m_loaded.emplace_back(std::move(loaded));
+			}
+		});
+		m_isDecoding = false;
+	});
+}
+
+////////////////////////////////////////////////////////////
+void ResourceHolder::processLoaded() {
+	const bool isDone{ !m_isDecoding }; // Read first: everything decoded by then is already queued
+	{
+		sf::Lock lock{ m_mutex };
+		for (auto& loaded : m_loaded) { storeResource(loaded); }
+		m_loaded.clear();
+		answerRequests(isDone);
 	}
+	if (isDone && m_loader.joinable()) { m_loader.join(); }
+}
+
+////////////////////////////////////////////////////////////
+void ResourceHolder::waitForLoading() {
+	if (m_loader.joinable()) { m_loader.join(); }
+	processLoaded();
+}
+
+////////////////////////////////////////////////////////////
+bool ResourceHolder::isLoading() {
+	sf::Lock lock{ m_mutex };
+	return m_isDecoding || !m_loaded.empty() || !m_requests.empty();
 }
 
+////////////////////////////////////////////////////////////
+std::shared_future<Resource*> ResourceHolder::getResourceAsync(const ResourceType& t_type, const std::string& t_resourceName) {
+	sf::Lock lock{ m_mutex };
+	for (auto& request : m_requests) {
+		if (request.m_type == t_type && request.m_name == t_resourceName) { return request.m_future; }
+	}
+
+	ResourceRequest request{ t_type, t_resourceName, std::promise<Resource*>(), std::shared_future<Resource*>() };
+	request.m_future = request.m_promise.get_future().share();
+	Resource* resource{ getResource(t_type, t_resourceName) };
+	if (resource || (!m_isDecoding && m_loaded.empty())) { // Either there or never will be
+		request.m_promise.set_value(resource);
+		return request.m_future;
+	}
+	m_requests.emplace_back(std::move(request));
+	return m_requests.back().m_future;
+}
 
 ////////////////////////////////////////////////////////////
 bool ResourceHolder::loadResources(const std::string& t_cfgFile, const std::string& t_resourceIdentifier) {
@@ -83,50 +145,72 @@ bool ResourceHolder::loadResources(const std::string& t_cfgFile, const std::stri
 ////////////////////////////////////////////////////////////
 bool ResourceHolder::loadResource(const ResourceType& t_type, const std::string& t_resourceName, const std::string& t_fileNameWithPath) {
 	sf::Lock lock{ m_mutex };
-	auto resource{ std::make_unique<Resource>() };
-	bool load_result{ false };
+	LoadedResource loaded{ decodeResource(t_type, t_resourceName, t_fileNameWithPath) };
+	return storeResource(loaded);
+}
+
+////////////////////////////////////////////////////////////
+LoadedResource ResourceHolder::decodeResource(const ResourceType& t_type, const std::string& t_resourceName, const std::string& t_fileNameWithPath)const {
+	LoadedResource loaded{ t_type, t_resourceName, t_fileNameWithPath, sf::Image(), nullptr, false };
+
+	// Without a window there is no gpu context: only the texture dimensions are kept and everything else is skipped
+	if (m_isHeadless && (t_type == ResourceType::Sound || t_type == ResourceType::Font)) {
+		loaded.m_isLoaded = true;
+		return loaded;
+	}
 
 	switch (t_type) {
 	case ResourceType::Texture:
-		*resource.get() = sf::Texture();
-		load_result = std::get<sf::Texture>(*resource.get()).loadFromFile(t_fileNameWithPath);
+		loaded.m_isLoaded = loaded.m_image.loadFromFile(t_fileNameWithPath);
 		break;
 	case ResourceType::Sound:
-		*resource.get() = sf::SoundBuffer();
-		load_result = std::get<sf::SoundBuffer>(*resource.get()).loadFromFile(t_fileNameWithPath);
+		loaded.m_resource = std::make_unique<Resource>(std::in_place_type<sf::SoundBuffer>);
+		loaded.m_isLoaded = std::get<sf::SoundBuffer>(*loaded.m_resource.get()).loadFromFile(t_fileNameWithPath);
 		break;
 	case ResourceType::Font:
-		*resource.get() = sf::Font();
-		load_result = std::get<sf::Font>(*resource.get()).loadFromFile(t_fileNameWithPath);
+		loaded.m_resource = std::make_unique<Resource>(std::in_place_type<sf::Font>);
+		loaded.m_isLoaded = std::get<sf::Font>(*loaded.m_resource.get()).loadFromFile(t_fileNameWithPath);
+		break;
+	default: // Unknown type: left unloaded, so storing it reports the failure
 		break;
 	}
+	return loaded;
+}
 
-	if (!load_result) {
-		std::string msg{ resourceTypeIdToStr(t_type) };
-		std::cerr << "@ ERROR: Failed to load " << (msg.empty() ? "resource" : msg) << " from file \"" << t_fileNameWithPath << '\"' << std::endl;
-		return false;
-	}
-
-	auto type_it{ m_resources.find(t_type) };
-	if (type_it == m_resources.end()) {
-
-		std::unordered_map<std::string, std::unique_ptr<Resource>> temp_map;
-		temp_map.emplace(t_resourceName, std::move(resource));
-		m_resources.emplace(t_type, std::move(temp_map));
-		return true;
+////////////////////////////////////////////////////////////
+bool ResourceHolder::storeResource(LoadedResource& t_loaded) {
+	if (t_loaded.m_isLoaded && t_loaded.m_type == ResourceType::Texture) {
+		if (m_isHeadless) {
+			m_textureSizes[t_loaded.m_name] = t_loaded.m_image.getSize();
+			return true;
+		}
+		t_loaded.m_resource = std::make_unique<Resource>(std::in_place_type<sf::Texture>);
+		t_loaded.m_isLoaded = std::get<sf::Texture>(*t_loaded.m_resource.get()).loadFromImage(t_loaded.m_image); // Gpu upload
 	}
 
-	auto str_it{ type_it->second.find(t_resourceName) };
-	if (str_it == type_it->second.cend()) {
-		type_it->second.emplace(t_resourceName, std::move(resource));
-		return true;
+	if (!t_loaded.m_isLoaded) {
+		std::string msg{ resourceTypeIdToStr(t_loaded.m_type) };
+		std::cerr << "@ ERROR: Failed to load " << (msg.empty() ? "resource" : msg) << " from file \"" << t_loaded.m_fileName << '\"' << std::endl;
+		return false;
 	}
+	if (!t_loaded.m_resource) { return true; } // Skipped while headless
 
-	str_it->second = std::move(resource);
+	m_resources[t_loaded.m_type][t_loaded.m_name] = std::move(t_loaded.m_resource);
 	return true;
 }
 
-
+////////////////////////////////////////////////////////////
+void ResourceHolder::answerRequests(bool t_isDone) {
+	for (auto it{ m_requests.begin() }; it != m_requests.end();) {
+		Resource* resource{ getResource(it->m_type, it->m_name) };
+		if (!resource && !t_isDone) {
+			it++;
+			continue;
+		}
+		it->m_promise.set_value(resource);
+		it = m_requests.erase(it);
+	}
+}
 
 ////////////////////////////////////////////////////////////
 void ResourceHolder::releaseResource(const ResourceType& t_type, const std::string& t_resourceName) {
@@ -147,9 +231,27 @@ Resource* ResourceHolder::getResource(const ResourceType& t_type, const std::str
 	return str_it->second.get();
 }
 
+////////////////////////////////////////////////////////////
+bool ResourceHolder::getTextureSize(const std::string& t_textureName, sf::Vector2u& t_out_size) {
+	auto size_it{ m_textureSizes.find(t_textureName) };
+	if (size_it != m_textureSizes.cend()) {
+		t_out_size = size_it->second;
+		return true;
+	}
+
+	Resource* texture_resource{ getResource(ResourceType::Texture, t_textureName) };
+	if (!texture_resource) { return false; }
+	t_out_size = std::get<sf::Texture>(*texture_resource).getSize();
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool ResourceHolder::isHeadless()const { return m_isHeadless; }
+
 
 ////////////////////////////////////////////////////////////
 void ResourceHolder::purgeResources() {
 	sf::Lock lock{ m_mutex };
 	m_resources.clear();
+	m_textureSizes.clear();
 }
\ No newline at end of file
@@ -1,21 +1,28 @@
 #ifndef RESOURCE_HOLDER_H
 #define RESOURCE_HOLDER_H
 
+#include <atomic>
+#include <future>
 #include <string>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 
 
 using Resource = std::variant<sf::Texture, sf::SoundBuffer, sf::Font>;
 enum class ResourceType;
+class JobSystem;
 using Resources = std::unordered_map<ResourceType, std::unordered_map<std::string, std::unique_ptr<Resource>>>;
 using ResourceTypeStrings = std::unordered_map<std::string, ResourceType>;
+using TextureSizes = std::unordered_map<std::string, sf::Vector2u>;
 
 enum class ResourceType {
 	INVALID_RESOURCE_TYPE = -1,
@@ -24,25 +31,70 @@ enum class ResourceType {
 	Font
 };
 
+// Decoded off the main thread, waiting to be stored
+struct LoadedResource {
+	ResourceType m_type;
+	std::string m_name;
+	std::string m_fileName;
+	sf::Image m_image; // Textures: uploaded to the gpu by the main thread
+	std::unique_ptr<Resource> m_resource; // Fonts and sounds, ready to use
+	bool m_isLoaded;
+};
+
+// Pending getResourceAsync()
+struct ResourceRequest {
+	ResourceType m_type;
+	std::string m_name;
+	std::promise<Resource*> m_promise;
+	std::shared_future<Resource*> m_future;
+};
+
 class ResourceHolder {
 
 	std::string m_workingDirPath;
 	Resources m_resources;
+	TextureSizes m_textureSizes; // Headless mode only keeps the dimensions of the textures (decoded on the cpu, no gpu upload)
+	bool m_isHeadless;
 	static const ResourceTypeStrings s_resourceTypeStrings;
 
 	sf::Mutex m_mutex;
 
+	// Background loading started by init()
+	std::thread m_loader;
+	std::atomic<bool> m_isDecoding;
+	std::vector<LoadedResource> m_loaded; // Decoded, not stored yet
+	std::vector<ResourceRequest> m_requests;
+
+	ResourceHolder(const ResourceHolder& t_rhs) = delete;
+
 public:
 	static const std::string& resourceTypeIdToStr(const ResourceType& t_id);
 	static ResourceType resourceTypeStrToId(const std::string& t_str);
 
-	ResourceHolder();
-	void init();
+	ResourceHolder(bool t_isHeadless = false);
+	~ResourceHolder();
+
+	// Decodes everything in the resources directory on the workers of t_jobSystem, from a thread of its own, and returns
+	//	right away. Textures are uploaded by processLoaded(), which has to be called from the thread that draws.
+	//	t_jobSystem is used from that thread until loading is done, so it must not run a parallelFor() of its own meanwhile.
+	void init(JobSystem& t_jobSystem);
+	void processLoaded(); // Main thread: stores what was decoded so far and answers the requests it can
+	void waitForLoading(); // Main thread: blocks until everything init() found is stored
+	bool isLoading();
+	std::shared_future<Resource*> getResourceAsync(const ResourceType& t_type, const std::string& t_resourceName); // nullptr if it never loads
+
 	bool loadResources(const std::string& t_cfgFile, const std::string& t_resourceIdentifier = "RESOURCE");
 	bool loadResource(const ResourceType& t_type, const std::string& t_resourceName, const std::string& t_fileNameWithPath);
 	void releaseResource(const ResourceType& t_type, const std::string& t_resourceName);
 	Resource* getResource(const ResourceType& t_type, const std::string& t_resourceName);
+	bool getTextureSize(const std::string& t_textureName, sf::Vector2u& t_out_size);
+	bool isHeadless()const;
 	void purgeResources();
+
+private:
+	LoadedResource decodeResource(const ResourceType& t_type, const std::string& t_resourceName, const std::string& t_fileNameWithPath)const; // Any thread
+	bool storeResource(LoadedResource& t_loaded); // Main thread
+	void answerRequests(bool t_isDone);
 };
 
 #endif // !RESOURCE_HOLDER_H
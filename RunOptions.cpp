@@ -0,0 +1,113 @@
+#include "RunOptions.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include "Engine.h"
+
+static const std::string S_OPTIONS[]{ "--seed", "--threads", "--load", "--save", "--telemetry", "--profile", "--headless" }; // All of them take a value
+
+////////////////////////////////////////////////////////////
+RunOptions::RunOptions() :
+	m_seed{ RandomGenerator::makeSeed() },
+	m_numWorkers{ JobSystem::getDefaultNumWorkers() },
+	m_isHeadless{ false },
+	m_ticks{ 0U },
+	m_simulatedTime{ 0.f }{}
+
+////////////////////////////////////////////////////////////
+bool RunOptions::parse(int argc, char* argv[], int t_first) {
+	for (int arg{ t_first }; arg < argc; arg += 2) {
+		const std::string option{ argv[arg] };
+		if (std::find(std::begin(S_OPTIONS), std::end(S_OPTIONS), option) == std::end(S_OPTIONS)) {
+			std::cerr << "@ ERROR: Unknown option " << option << "!" << std::endl;
+			return false;
+		}
+		if (arg + 1 >= argc) {
+			std::cerr << "@ ERROR: Missing value for option " << option << "!" << std::endl;
+			return false;
+		}
+
+		const char* value{ argv[arg + 1] };
+		unsigned long long count{ 0U };
+		if (option == "--seed") {
+			if (!parseCount(option, value, count)) { return false; }
+			m_seed = count;
+		}
+		else if (option == "--threads") {
+			if (!parseCount(option, value, count)) { return false; }
+			if (count > std::numeric_limits<unsigned>::max()) {
+				std::cerr << "@ ERROR: Too many threads for option " << option << "!" << std::endl;
+				return false;
+			}
+			m_numWorkers = static_cast<unsigned>(count);
+		}
+		else if (option == "--load") { m_loadFile = value; }
+		else if (option == "--save") { m_saveFile = value; }
+		else if (option == "--telemetry") { m_telemetryFile = value; }
+		else if (option == "--profile") { m_profileFile = value; }
+		else if (option == "--headless") {
+			m_isHeadless = true;
+			if (!parseCount(option, value, m_ticks)) { return false; }
+			if (arg + 2 < argc && !parseSeconds(option, argv[arg + 2], m_simulatedTime)) { return false; }
+			if (arg + 3 < argc) {
+				std::cerr << "@ ERROR: --headless has to be the last option!" << std::endl;
+				return false;
+			}
+			break;
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool RunOptions::parseCount(const std::string& t_option, const char* t_value, unsigned long long& t_out_value) {
+	char* end{ nullptr };
+	errno = 0;
+	const unsigned long long value{ std::strtoull(t_value, &end, 10) };
+	if (!std::isdigit(static_cast<unsigned char>(t_value[0])) || *end != '\0' || errno == ERANGE) {
+		std::cerr << "@ ERROR: Invalid value \"" << t_value << "\" for option " << t_option << ": expected a whole number!" << std::endl;
+		return false;
+	}
+	t_out_value = value;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool RunOptions::parseSeconds(const std::string& t_option, const char* t_value, float& t_out_value) {
+	char* end{ nullptr };
+	errno = 0;
+	const float value{ std::strtof(t_value, &end) };
+	if (end == t_value || *end != '\0' || errno == ERANGE || !std::isfinite(value) || value < 0.f) {
+		std::cerr << "@ ERROR: Invalid value \"" << t_value << "\" for option " << t_option << ": expected seconds!" << std::endl;
+		return false;
+	}
+	t_out_value = value;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+int runHeadless(const RunOptions& t_options) {
+	Engine engine{ sf::Vector2u(1080,1080),"Test", true, t_options.m_numWorkers, t_options.m_seed, t_options.m_loadFile };
+	if (!t_options.m_telemetryFile.empty() && !engine.openTelemetry(t_options.m_telemetryFile)) { return 1; }
+	engine.runHeadless(t_options.m_ticks, t_options.m_simulatedTime);
+	if (!t_options.m_profileFile.empty() && !engine.writeProfile(t_options.m_profileFile)) { return 1; }
+	if (!t_options.m_saveFile.empty()) {
+		engine.saveSnapshot(t_options.m_saveFile);
+		if (!engine.waitForSnapshotWrite()) { return 1; }
+		std::cout << "> Saved " << t_options.m_saveFile << std::endl;
+	}
+	return 0;
+}
+
+////////////////////////////////////////////////////////////
+int runWindowed(const RunOptions& t_options) {
+	Engine engine{ sf::Vector2u(1080,1080),"Test", false, t_options.m_numWorkers, t_options.m_seed, t_options.m_loadFile };
+	if (!t_options.m_telemetryFile.empty() && !engine.openTelemetry(t_options.m_telemetryFile)) { return 1; }
+	engine.run();
+	if (!t_options.m_profileFile.empty() && !engine.writeProfile(t_options.m_profileFile)) { return 1; }
+	return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef RUN_OPTIONS_H
+#define RUN_OPTIONS_H
+
+#include <cstdint>
+#include <string>
+
+// Command line of a simulation run, shared by the app and the headless runner:
+//	[--seed <seed>] [--threads <workers>] [--load <file>] [--save <file>] [--telemetry <file>] [--profile <file>] [--headless <ticks> [<simulated seconds>]]
+struct RunOptions {
+	std::uint64_t m_seed; // Runs with the same seed and tick count end with the same population
+	unsigned m_numWorkers;
+	std::string m_loadFile; // Snapshot to resume from; its seed replaces the one above
+	std::string m_saveFile; // Snapshot written when a headless run ends
+	std::string m_telemetryFile; // Compressed columnar, or CSV if it ends in .csv
+	std::string m_profileFile; // Phase timings written when the run ends
+	bool m_isHeadless;
+	unsigned long long m_ticks;
+	float m_simulatedTime;
+
+	RunOptions();
+	bool parse(int argc, char* argv[], int t_first = 1); // Prints the unknown option or the missing or invalid value, if any
+
+	// The whole value has to be a number: signs, trailing characters and overflows are rejected. Print what is wrong
+	static bool parseCount(const std::string& t_option, const char* t_value, unsigned long long& t_out_value);
+	static bool parseSeconds(const std::string& t_option, const char* t_value, float& t_out_value);
+};
+
+int runHeadless(const RunOptions& t_options); // Both return the exit code of the program
+int runWindowed(const RunOptions& t_options);
+
+#endif // !RUN_OPTIONS_H
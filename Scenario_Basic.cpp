@@ -55,7 +55,6 @@ void Scenario_Basic::init() {
 		food->setPosition({ x,y });
 		food->setRotation(rot);
 		static_cast<Food*>(food.get())->setEnergy(energyFactor * S_FOOD_ENERGY);
-		food->setTextString("Food: " + std::to_string(static_cast<int>(static_cast<Food*>(food.get())->getEnergy())));
 		m_context.m_engine->spawnActor(std::move(food));
 	}
 }
@@ -75,7 +74,6 @@ void Scenario_Basic::update(const float& t_elapsed) {
 		food->setPosition({ x,y });
 		food->setRotation(rot);
 		static_cast<Food*>(food.get())->setEnergy(energyFactor * S_FOOD_ENERGY);
-		food->setTextString("Food: " + std::to_string(static_cast<int>(static_cast<Food*>(food.get())->getEnergy())));
 		m_context.m_engine->spawnActor(std::move(food));
 	}
 
@@ -83,7 +81,13 @@ void Scenario_Basic::update(const float& t_elapsed) {
 }
 
 ////////////////////////////////////////////////////////////
-void Scenario_Basic::addEnergy(const float& t_e) { m_energyPool += t_e; if (m_energyPool > m_maxEnergy) { m_energyPool = m_maxEnergy; } }
+void Scenario_Basic::addEnergy(const float& t_e) {
+	if (auto buffer{ Engine::getUpdateBuffer() }) { buffer->m_energy += t_e; return; } // Applied after the parallel actor update
+	m_energyPool += t_e; if (m_energyPool > m_maxEnergy) { m_energyPool = m_maxEnergy; }
+}
+
+////////////////////////////////////////////////////////////
+const float& Scenario_Basic::getEnergy() const { return m_energyPool; }
 
 ////////////////////////////////////////////////////////////
-const float& Scenario_Basic::getEnergy() const { return m_energyPool; }
\ No newline at end of file
+void Scenario_Basic::setEnergy(const float& t_e) { m_energyPool = t_e; }
\ No newline at end of file
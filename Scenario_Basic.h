@@ -5,6 +5,15 @@
 #include "Organism.h"
 #include "Food.h"
 
+// Size and population of a run; the defaults are the standard scenario
+struct ScenarioSettings {
+	float m_energy{ 300000.f }; // Total in the environment
+	unsigned m_numOrganisms{ 15U };
+	unsigned m_maxNumOrganisms{ 100U };
+	unsigned m_numFood{ 200U }; // Kept up by the scenario
+	float m_width{ 3000.f };
+	float m_height{ 3000.f };
+};
 
 class Scenario_Basic : public Scenario_Base {
 
@@ -35,6 +44,7 @@ public:
 
 	void addEnergy(const float& t_e); // Returns energy from the environment
 	const float& getEnergy()const;
+	void setEnergy(const float& t_e); // Overwrites the pool, e.g. when loading a snapshot
 };
 
 #endif // !SCENARIO_BASIC_H
\ No newline at end of file
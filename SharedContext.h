@@ -14,19 +14,22 @@ struct SharedContext {
 	Engine* m_engine;
 	RandomGenerator* m_rng;
 	ResourceHolder* m_resourceHolder;
+	bool m_isHeadless; // No window, textures or fonts; actors skip all of their SFML work
 
 	////////////////////////////////////////////////////////////
-	SharedContext() : m_window{ nullptr }, m_engine{ nullptr }, m_rng{ nullptr }, m_resourceHolder{ nullptr }{}
+	SharedContext() : m_window{ nullptr }, m_engine{ nullptr }, m_rng{ nullptr }, m_resourceHolder{ nullptr }, m_isHeadless{ false }{}
 	////////////////////////////////////////////////////////////
 	SharedContext(
 		sf::RenderWindow& t_window,
 		Engine& t_engine,
 		RandomGenerator& t_rng,
-		ResourceHolder& t_resourceHolder) :
+		ResourceHolder& t_resourceHolder,
+		bool t_isHeadless = false) :
 		m_window{ &t_window },
 		m_engine{ &t_engine },
 		m_rng{ &t_rng },
-		m_resourceHolder{ &t_resourceHolder }
+		m_resourceHolder{ &t_resourceHolder },
+		m_isHeadless{ t_isHeadless }
 	{
 	}
 
@@ -35,7 +38,8 @@ struct SharedContext {
 		m_window{ t_rhs.m_window },
 		m_engine{ t_rhs.m_engine },
 		m_rng{ t_rhs.m_rng },
-		m_resourceHolder{ t_rhs.m_resourceHolder }
+		m_resourceHolder{ t_rhs.m_resourceHolder },
+		m_isHeadless{ t_rhs.m_isHeadless }
 	{
 	}
 };
@@ -0,0 +1,252 @@
+#include "Snapshot.h"
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+////////////////////////////////////////////////////////////
+const std::uint32_t Snapshot::s_magic{ 0x534E5347U }; // "GSNS"
+
+////////////////////////////////////////////////////////////
+const std::uint32_t Snapshot::s_version{ 2U };
+
+////////////////////////////////////////////////////////////
+const std::uint32_t Snapshot::s_noOwner{ ~0U };
+
+static const std::size_t S_SECTION_ALIGNMENT{ 64U }; // Cache line; also enough for any record
+static const std::uint64_t S_FNV_OFFSET_BASIS{ 0xCBF29CE484222325ULL };
+static const std::uint64_t S_FNV_PRIME{ 0x100000001B3ULL };
+
+static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "Snapshot headers are read in place");
+static_assert(std::is_trivially_copyable<OrganismSnapshot>::value, "Snapshot records are read in place");
+static_assert(std::is_trivially_copyable<FoodSnapshot>::value, "Snapshot records are read in place");
+static_assert(std::is_trivially_copyable<ActorRef>::value, "Snapshot records are read in place");
+
+
+// -------------------------------------------------------- FILE LAYOUT	-----------------------------------------
+
+////////////////////////////////////////////////////////////
+static std::size_t toIndex(const SnapshotSection& t_section) { return static_cast<std::size_t>(t_section); }
+
+////////////////////////////////////////////////////////////
+static std::uint64_t align(const std::uint64_t& t_offset) { return (t_offset + S_SECTION_ALIGNMENT - 1U) / S_SECTION_ALIGNMENT * S_SECTION_ALIGNMENT; }
+
+////////////////////////////////////////////////////////////
+static std::uint64_t hash(std::uint64_t t_hash, const void* t_data, const std::size_t& t_size) {
+	// FNV-1a over 64 bit words rather than bytes, so checking a large snapshot runs at memory speed
+	const std::uint8_t* bytes{ static_cast<const std::uint8_t*>(t_data) };
+	std::size_t i{ 0U };
+	for (; i + sizeof(std::uint64_t) <= t_size; i += sizeof(std::uint64_t)) {
+		std::uint64_t word;
+		std::memcpy(&word, bytes + i, sizeof(word));
+		t_hash = (t_hash ^ word) * S_FNV_PRIME;
+	}
+	for (; i < t_size; i++) { t_hash = (t_hash ^ bytes[i]) * S_FNV_PRIME; }
+	return t_hash;
+}
+
+////////////////////////////////////////////////////////////
+static void writePadding(std::ostream& t_out, std::uint64_t& t_position, const std::uint64_t& t_offset) {
+	static const std::array<char, S_SECTION_ALIGNMENT> zeros{};
+	t_out.write(zeros.data(), static_cast<std::streamsize>(t_offset - t_position));
+	t_position = t_offset;
+}
+
+// -------------------------------------------------------- file layout	-----------------------------------------
+
+
+////////////////////////////////////////////////////////////
+void Snapshot::clear() {
+	for (auto& column : m_columns) { column.clear(); }
+	m_flags.clear();
+	m_rowOwners.clear();
+	m_organisms.clear();
+	m_genomes.clear();
+	m_names.clear();
+	m_food.clear();
+	m_actors.clear();
+	m_spawnList.clear();
+}
+
+////////////////////////////////////////////////////////////
+bool Snapshot::writeToFile(const std::string& t_fileName)const {
+	const std::uint64_t numRows{ m_flags.size() };
+	for (const auto& column : m_columns) { if (column.size() != numRows) { return false; } }
+
+	// Bytes of every section, in file order
+	using Bytes = std::pair<const void*, std::size_t>;
+	std::array<std::vector<Bytes>, static_cast<std::size_t>(SnapshotSection::SECTION_COUNT)> sections;
+	for (const auto& column : m_columns) { sections[toIndex(SnapshotSection::Columns)].emplace_back(column.data(), column.size() * sizeof(float)); }
+	sections[toIndex(SnapshotSection::Flags)].emplace_back(m_flags.data(), m_flags.size());
+	sections[toIndex(SnapshotSection::RowOwners)].emplace_back(m_rowOwners.data(), m_rowOwners.size() * sizeof(std::uint32_t));
+	sections[toIndex(SnapshotSection::Organisms)].emplace_back(m_organisms.data(), m_organisms.size() * sizeof(OrganismSnapshot));
+	sections[toIndex(SnapshotSection::Genomes)].emplace_back(m_genomes.data(), m_genomes.size() * sizeof(TraitCollection));
+	sections[toIndex(SnapshotSection::Names)].emplace_back(m_names.data(), m_names.size());
+	sections[toIndex(SnapshotSection::Food)].emplace_back(m_food.data(), m_food.size() * sizeof(FoodSnapshot));
+	sections[toIndex(SnapshotSection::Actors)].emplace_back(m_actors.data(), m_actors.size() * sizeof(ActorRef));
+	sections[toIndex(SnapshotSection::SpawnList)].emplace_back(m_spawnList.data(), m_spawnList.size() * sizeof(ActorRef));
+
+	SnapshotHeader header{};
+	header.m_magic = s_magic;
+	header.m_version = s_version;
+	header.m_headerSize = sizeof(SnapshotHeader);
+	header.m_numTraits = static_cast<std::uint32_t>(NUM_TRAITS);
+	header.m_numFields = static_cast<std::uint32_t>(OrganismField::FIELD_COUNT);
+	header.m_organismSize = sizeof(OrganismSnapshot);
+	header.m_foodSize = sizeof(FoodSnapshot);
+	header.m_genomeSize = sizeof(TraitCollection);
+	header.m_numRows = numRows;
+	header.m_tickCount = m_tickCount;
+	header.m_seed = m_seed;
+	header.m_rngCounter = m_rngCounter;
+	header.m_energyPool = m_energyPool;
+	header.m_numFood = m_numFood;
+	header.m_perlinPermutations = m_perlinPermutations;
+
+	const std::array<std::uint64_t, static_cast<std::size_t>(SnapshotSection::SECTION_COUNT)> counts{
+		numRows * m_columns.size(), numRows, m_rowOwners.size(), m_organisms.size(), m_genomes.size(),
+		m_names.size(), m_food.size(), m_actors.size(), m_spawnList.size() };
+	std::uint64_t offset{ align(sizeof(SnapshotHeader)) };
+	header.m_checksum = S_FNV_OFFSET_BASIS;
+	for (std::size_t i{ 0U }; i < sections.size(); i++) {
+		header.m_sections[i] = { offset, counts[i] };
+		for (const auto& bytes : sections[i]) {
+			header.m_checksum = hash(header.m_checksum, bytes.first, bytes.second);
+			offset += bytes.second;
+		}
+		offset = align(offset);
+	}
+
+	std::ofstream out{ t_fileName, std::ios::binary | std::ios::trunc };
+	if (!out) { return false; }
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	std::uint64_t position{ sizeof(header) };
+	for (std::size_t i{ 0U }; i < sections.size(); i++) {
+		writePadding(out, position, header.m_sections[i].m_offset);
+		for (const auto& bytes : sections[i]) {
+			out.write(static_cast<const char*>(bytes.first), static_cast<std::streamsize>(bytes.second));
+			position += bytes.second;
+		}
+	}
+	writePadding(out, position, align(position)); // Every section, the last one too, ends on the alignment
+	return static_cast<bool>(out);
+}
+
+
+////////////////////////////////////////////////////////////
+SnapshotView::SnapshotView() : m_header{ nullptr } {}
+
+////////////////////////////////////////////////////////////
+bool SnapshotView::open(const std::string& t_fileName) {
+	close();
+	if (!m_file.open(t_fileName)) { return false; }
+	if (m_file.getSize() >= sizeof(SnapshotHeader)) { m_header = reinterpret_cast<const SnapshotHeader*>(m_file.getData()); }
+	if (!m_header || !isValid()) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void SnapshotView::close() {
+	m_header = nullptr;
+	m_file.close();
+}
+
+////////////////////////////////////////////////////////////
+const SnapshotHeader& SnapshotView::getHeader()const { return *m_header; }
+
+////////////////////////////////////////////////////////////
+const float* SnapshotView::getColumn(const OrganismField& t_field)const {
+	return getTable<float>(SnapshotSection::Columns).data() + static_cast<std::size_t>(t_field) * m_header->m_numRows;
+}
+
+////////////////////////////////////////////////////////////
+SnapshotTable<std::uint8_t> SnapshotView::getFlags()const { return getTable<std::uint8_t>(SnapshotSection::Flags); }
+
+////////////////////////////////////////////////////////////
+SnapshotTable<std::uint32_t> SnapshotView::getRowOwners()const { return getTable<std::uint32_t>(SnapshotSection::RowOwners); }
+
+////////////////////////////////////////////////////////////
+SnapshotTable<OrganismSnapshot> SnapshotView::getOrganisms()const { return getTable<OrganismSnapshot>(SnapshotSection::Organisms); }
+
+////////////////////////////////////////////////////////////
+SnapshotTable<TraitCollection> SnapshotView::getGenomes()const { return getTable<TraitCollection>(SnapshotSection::Genomes); }
+
+////////////////////////////////////////////////////////////
+SnapshotTable<FoodSnapshot> SnapshotView::getFood()const { return getTable<FoodSnapshot>(SnapshotSection::Food); }
+
+////////////////////////////////////////////////////////////
+SnapshotTable<ActorRef> SnapshotView::getActors()const { return getTable<ActorRef>(SnapshotSection::Actors); }
+
+////////////////////////////////////////////////////////////
+SnapshotTable<ActorRef> SnapshotView::getSpawnList()const { return getTable<ActorRef>(SnapshotSection::SpawnList); }
+
+////////////////////////////////////////////////////////////
+std::string SnapshotView::getName(const OrganismSnapshot& t_organism)const {
+	return std::string(getTable<char>(SnapshotSection::Names).data() + t_organism.m_nameOffset, t_organism.m_nameLength);
+}
+
+////////////////////////////////////////////////////////////
+template<typename T>
+SnapshotTable<T> SnapshotView::getTable(const SnapshotSection& t_section)const {
+	const SnapshotSectionInfo& info{ m_header->m_sections[toIndex(t_section)] };
+	return SnapshotTable<T>(reinterpret_cast<const T*>(m_file.getData() + info.m_offset), static_cast<std::size_t>(info.m_count));
+}
+
+////////////////////////////////////////////////////////////
+template<typename T>
+bool SnapshotView::isSectionValid(const SnapshotSection& t_section)const {
+	const SnapshotSectionInfo& info{ m_header->m_sections[toIndex(t_section)] };
+	return info.m_offset % alignof(T) == 0U && info.m_offset <= m_file.getSize() &&
+		info.m_count <= (m_file.getSize() - info.m_offset) / sizeof(T);
+}
+
+////////////////////////////////////////////////////////////
+bool SnapshotView::isValid()const {
+	const SnapshotHeader& header{ *m_header };
+	if (header.m_magic != Snapshot::s_magic || header.m_version != Snapshot::s_version || header.m_headerSize != sizeof(SnapshotHeader) ||
+		header.m_numTraits != NUM_TRAITS || header.m_numFields != static_cast<std::uint32_t>(OrganismField::FIELD_COUNT) ||
+		header.m_organismSize != sizeof(OrganismSnapshot) || header.m_foodSize != sizeof(FoodSnapshot) ||
+		header.m_genomeSize != sizeof(TraitCollection)) { return false; }
+
+	if (!isSectionValid<float>(SnapshotSection::Columns) || !isSectionValid<std::uint8_t>(SnapshotSection::Flags) ||
+		!isSectionValid<std::uint32_t>(SnapshotSection::RowOwners) || !isSectionValid<OrganismSnapshot>(SnapshotSection::Organisms) ||
+		!isSectionValid<TraitCollection>(SnapshotSection::Genomes) || !isSectionValid<char>(SnapshotSection::Names) ||
+		!isSectionValid<FoodSnapshot>(SnapshotSection::Food) || !isSectionValid<ActorRef>(SnapshotSection::Actors) ||
+		!isSectionValid<ActorRef>(SnapshotSection::SpawnList)) { return false; }
+
+	const std::uint64_t numRows{ header.m_numRows };
+	const auto organisms{ getOrganisms() };
+	if (getTable<float>(SnapshotSection::Columns).size() != numRows * header.m_numFields || getFlags().size() != numRows ||
+		getRowOwners().size() != numRows || getGenomes().size() != organisms.size()) { return false; }
+
+	// Same order as the writer: every column on its own, then every other section
+	std::uint64_t checksum{ S_FNV_OFFSET_BASIS };
+	for (std::size_t i{ 0U }; i < header.m_numFields; i++) {
+		checksum = hash(checksum, getColumn(static_cast<OrganismField>(i)), static_cast<std::size_t>(numRows) * sizeof(float));
+	}
+	for (std::size_t i{ toIndex(SnapshotSection::Flags) }; i < header.m_sections.size(); i++) {
+		static const std::array<std::size_t, static_cast<std::size_t>(SnapshotSection::SECTION_COUNT)> elementSizes{
+			sizeof(float), sizeof(std::uint8_t), sizeof(std::uint32_t), sizeof(OrganismSnapshot), sizeof(TraitCollection),
+			sizeof(char), sizeof(FoodSnapshot), sizeof(ActorRef), sizeof(ActorRef) };
+		const SnapshotSectionInfo& info{ header.m_sections[i] };
+		checksum = hash(checksum, m_file.getData() + info.m_offset, static_cast<std::size_t>(info.m_count) * elementSizes[i]);
+	}
+	if (checksum != header.m_checksum) { return false; }
+
+	// Everything has to point inside the snapshot
+	const std::uint64_t numNames{ getTable<char>(SnapshotSection::Names).size() };
+	for (const auto& organism : organisms) {
+		if (organism.m_slot >= numRows || static_cast<std::uint64_t>(organism.m_nameOffset) + organism.m_nameLength > numNames) { return false; }
+	}
+	for (const auto& owner : getRowOwners()) { if (owner != Snapshot::s_noOwner && owner >= organisms.size()) { return false; } }
+	for (const auto& refs : { getActors(), getSpawnList() }) {
+		for (const auto& ref : refs) {
+			if (ref.m_type == ActorType::Organism && ref.m_index < organisms.size()) { continue; }
+			if (ref.m_type == ActorType::Food && ref.m_index < getFood().size()) { continue; }
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,159 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Actor_Base.h"
+#include "MappedFile.h"
+#include "OrganismStore.h"
+#include "TraitCollection.h"
+
+// Snapshot files are laid out to be mapped and read in place: a header, then one section per table, each
+//	starting on a cache line. Tables hold plain records and the organism store columns as they are in memory,
+//	so a file is only meant to be loaded by a build with the same schema version and record sizes, which the header checks.
+
+// State shared by every kind of actor
+struct ActorSnapshot {
+	sf::Vector2f m_position;
+	float m_rotation;
+	sf::Color m_color;
+	bool m_destroy; // Actors waiting to be removed at the start of the next tick
+};
+
+struct OrganismSnapshot : ActorSnapshot {
+	std::uint32_t m_slot; // Row of the organism in the store columns of the snapshot
+	float m_destructionDelay;
+	std::uint32_t m_nameOffset; // Into the name table
+	std::uint32_t m_nameLength;
+}; // Its traits are the entry of the genome table with the same index
+
+struct FoodSnapshot : ActorSnapshot {
+	float m_energy;
+	float m_age;
+	float m_duration;
+	bool m_wasEaten;
+};
+
+struct ActorRef {
+	ActorType m_type;
+	std::uint32_t m_index; // Into the organisms or the food of the snapshot
+};
+
+enum class SnapshotSection : std::uint32_t {
+	Columns,	// Every organism store column, one after the other
+	Flags,
+	RowOwners,
+	Organisms,
+	Genomes,
+	Names,
+	Food,
+	Actors,
+	SpawnList,
+	SECTION_COUNT
+};
+
+struct SnapshotSectionInfo {
+	std::uint64_t m_offset; // In bytes from the start of the file
+	std::uint64_t m_count; // Of elements
+};
+
+struct SnapshotHeader {
+	std::uint32_t m_magic;
+	std::uint32_t m_version; // Of the schema
+	std::uint32_t m_headerSize;
+	std::uint32_t m_numTraits;
+	std::uint32_t m_numFields;
+	std::uint32_t m_organismSize; // Record sizes; a build that lays them out differently can't read the file
+	std::uint32_t m_foodSize;
+	std::uint32_t m_genomeSize;
+	std::uint64_t m_checksum; // Of every section
+	std::uint64_t m_numRows; // Of the organism store
+	std::uint64_t m_tickCount;
+	std::uint64_t m_seed;
+	std::uint64_t m_rngCounter;
+	float m_energyPool;
+	std::uint32_t m_numFood;
+	std::array<std::uint8_t, 256> m_perlinPermutations;
+	std::array<SnapshotSectionInfo, static_cast<std::size_t>(SnapshotSection::SECTION_COUNT)> m_sections;
+};
+
+// World state between two ticks, enough to resume the run exactly where it was. The organism store is kept
+//	row by row as it was, so every loop over it runs in the same order after loading.
+//	Captures are written to disk with writeToFile and read back, mapped, through a SnapshotView.
+struct Snapshot {
+	static const std::uint32_t s_magic;
+	static const std::uint32_t s_version;
+	static const std::uint32_t s_noOwner; // Store rows not saved with the snapshot (the scenario's templates)
+
+	std::uint64_t m_tickCount{ 0U };
+	std::uint64_t m_seed{ 0U };
+	std::uint64_t m_rngCounter{ 0U };
+	std::array<std::uint8_t, 256> m_perlinPermutations{};
+	float m_energyPool{ 0.f };
+	std::uint32_t m_numFood{ 0U };
+
+	OrganismColumns m_columns;
+	std::vector<std::uint8_t> m_flags;
+	std::vector<std::uint32_t> m_rowOwners; // Organism of every store row
+
+	std::vector<OrganismSnapshot> m_organisms;
+	std::vector<TraitCollection> m_genomes; // One per organism
+	std::string m_names; // Every organism's name, back to back
+	std::vector<FoodSnapshot> m_food;
+	std::vector<ActorRef> m_actors; // In simulation order
+	std::vector<ActorRef> m_spawnList; // Waiting for energy to spawn
+
+	void clear(); // Keeps the memory, so a reused snapshot doesn't allocate again
+	bool writeToFile(const std::string& t_fileName)const;
+};
+
+template<typename T>
+class SnapshotTable { // Read-only window on a section of a mapped snapshot
+	const T* m_data;
+	std::size_t m_size;
+
+public:
+	SnapshotTable(const T* t_data = nullptr, const std::size_t& t_size = 0U) : m_data{ t_data }, m_size{ t_size } {}
+	const T* data()const { return m_data; }
+	const std::size_t& size()const { return m_size; }
+	const T* begin()const { return m_data; }
+	const T* end()const { return m_data + m_size; }
+	const T& operator[](const std::size_t& t_index)const { return m_data[t_index]; }
+};
+
+// A snapshot file mapped into memory. Opening it checks the header, the checksum and that every index
+//	points inside the file; the tables are then read in place, without parsing nor copying them.
+class SnapshotView {
+
+	MappedFile m_file;
+	const SnapshotHeader* m_header;
+
+public:
+	SnapshotView();
+	bool open(const std::string& t_fileName);
+	void close();
+
+	const SnapshotHeader& getHeader()const;
+	const float* getColumn(const OrganismField& t_field)const; // getHeader().m_numRows values
+	SnapshotTable<std::uint8_t> getFlags()const;
+	SnapshotTable<std::uint32_t> getRowOwners()const;
+	SnapshotTable<OrganismSnapshot> getOrganisms()const;
+	SnapshotTable<TraitCollection> getGenomes()const;
+	SnapshotTable<FoodSnapshot> getFood()const;
+	SnapshotTable<ActorRef> getActors()const;
+	SnapshotTable<ActorRef> getSpawnList()const;
+	std::string getName(const OrganismSnapshot& t_organism)const;
+
+private:
+	template<typename T>
+	SnapshotTable<T> getTable(const SnapshotSection& t_section)const;
+	template<typename T>
+	bool isSectionValid(const SnapshotSection& t_section)const;
+	bool isValid()const;
+};
+
+#endif // !SNAPSHOT_H
@@ -0,0 +1,251 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "Collider.h"
+#include "PreprocessorDirectves.h"
+
+const float SpatialGrid::S_MIN_CELL_SIZE{ 32.f };
+const float SpatialGrid::S_MAX_CELLS_PER_OBJECT{ 2.f };
+const unsigned SpatialGrid::NO_CELL{ static_cast<unsigned>(-1) };
+
+
+////////////////////////////////////////////////////////////
+SpatialGrid::SpatialGrid(const sf::FloatRect& t_bounds, const float& t_minCellSize) :
+	m_bounds{ t_bounds },
+	m_minCellSize{ t_minCellSize },
+	m_columns{ 1U },
+	m_rows{ 1U },
+	m_cellWidth{ t_bounds.width },
+	m_cellHeight{ t_bounds.height }
+{
+	resize(m_minCellSize);
+}
+
+////////////////////////////////////////////////////////////
+const sf::FloatRect& SpatialGrid::getBounds()const { return m_bounds; }
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::setBounds(const sf::FloatRect& t_bounds) {
+	m_bounds = t_bounds;
+	resize(m_minCellSize);
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::insert(Collider* t_obj) {
+	slot(t_obj) = static_cast<int>(m_objects.size());
+	m_objects.emplace_back(t_obj);
+	m_objectCells.emplace_back(NO_CELL); // Binned in the next update()
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::remove(Collider* t_obj) {
+	const int index{ slot(t_obj) };
+	if (index == NO_SLOT) { return; }
+
+	// Out of its cell: swapped with the last object of the cell, which then ends one earlier
+	const unsigned cell{ m_objectCells[index] };
+	if (cell != NO_CELL) {
+		auto it{ std::find(m_cellObjects.begin() + m_cellStarts[cell], m_cellObjects.begin() + m_cellEnds[cell], t_obj) };
+		*it = m_cellObjects[--m_cellEnds[cell]];
+	}
+
+	// Fill the hole with the last object
+	m_objects[index] = m_objects.back();
+	m_objectCells[index] = m_objectCells.back();
+	slot(m_objects[index]) = index;
+	m_objects.pop_back();
+	m_objectCells.pop_back();
+	slot(t_obj) = NO_SLOT;
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::relocate(Collider* t_obj) {
+	if (slot(t_obj) == NO_SLOT) { insert(t_obj); }
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::clear() {
+	for (auto& obj : m_objects) { slot(obj) = NO_SLOT; }
+	m_objects.clear();
+	m_objectCells.clear();
+	m_cellObjects.clear();
+	std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0U);
+	std::fill(m_cellEnds.begin(), m_cellEnds.end(), 0U);
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::update() {
+	// Cells must fit the biggest object for the neighbour search to be exact
+	float maxExtent{ 0.f };
+	for (auto& obj : m_objects) {
+		const auto aabb{ obj->getAABB() };
+		maxExtent = std::max(maxExtent, std::max(aabb.width, aabb.height));
+	}
+	// ... and no more cells than about twice the objects, or sparse worlds spend their time walking empty cells
+	const float area{ m_bounds.width * m_bounds.height };
+	const float sparseCellSize{ m_objects.empty() ? 0.f : std::sqrt(area / (S_MAX_CELLS_PER_OBJECT * m_objects.size())) };
+	resize(std::max({ m_minCellSize, maxExtent, sparseCellSize }));
+
+	// Counting sort of the objects by the cell of their center
+	const std::size_t numCells{ static_cast<std::size_t>(m_columns) * m_rows };
+	m_cellStarts.assign(numCells + 1U, 0U);
+	m_objectCells.resize(m_objects.size());
+	for (std::size_t i{ 0U }; i < m_objects.size(); i++) {
+		const auto center{ m_objects[i]->getCenterPos() };
+		const unsigned cell{ wrapRow(getRow(center.y)) * m_columns + wrapColumn(getColumn(center.x)) };
+		m_objectCells[i] = cell;
+		m_cellStarts[cell + 1U]++;
+	}
+	for (std::size_t c{ 1U }; c <= numCells; c++) { m_cellStarts[c] += m_cellStarts[c - 1U]; }
+
+	m_cellObjects.resize(m_objects.size());
+	for (std::size_t i{ 0U }; i < m_objects.size(); i++) {
+		m_cellObjects[m_cellStarts[m_objectCells[i]]++] = m_objects[i];
+	}
+
+	// Scattering left every start at the end of its cell; shift them back
+	m_cellEnds.assign(m_cellStarts.begin(), m_cellStarts.end() - 1);
+	for (std::size_t c{ numCells }; c > 0U; c--) { m_cellStarts[c] = m_cellStarts[c - 1U]; }
+	m_cellStarts[0] = 0U;
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::getPotentialOverlaps(Objects& t_out_objects, const sf::FloatRect& t_aabb)const {
+	if (m_cellStarts.empty()) { return; }
+
+	// Any object touching the aabb has its center at most half a cell away from it
+	const int firstColumn{ getColumn(t_aabb.left - m_cellWidth * 0.5f) };
+	const int firstRow{ getRow(t_aabb.top - m_cellHeight * 0.5f) };
+	const int numColumns{ std::min(getColumn(t_aabb.left + t_aabb.width + m_cellWidth * 0.5f) - firstColumn + 1, static_cast<int>(m_columns)) };
+	const int numRows{ std::min(getRow(t_aabb.top + t_aabb.height + m_cellHeight * 0.5f) - firstRow + 1, static_cast<int>(m_rows)) };
+
+	for (int r{ 0 }; r < numRows; r++) {
+		const unsigned row{ wrapRow(firstRow + r) };
+		for (int c{ 0 }; c < numColumns; c++) {
+			const unsigned cell{ row * m_columns + wrapColumn(firstColumn + c) };
+			t_out_objects.insert(t_out_objects.end(), m_cellObjects.begin() + m_cellStarts[cell], m_cellObjects.begin() + m_cellEnds[cell]);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::getCandidatePairs(CandidatePairs& t_out_pairs)const {
+	if (m_cellStarts.empty()) { return; }
+
+	// Half of the neighbourhood per cell, so each pair of adjacent cells is visited once
+	static const int S_NEIGHBOURS[4][2]{ {1,0}, {-1,1}, {0,1}, {1,1} };
+
+	for (unsigned row{ 0U }; row < m_rows; row++) {
+		for (unsigned column{ 0U }; column < m_columns; column++) {
+			const unsigned cell{ row * m_columns + column };
+			const unsigned begin{ m_cellStarts[cell] };
+			const unsigned end{ m_cellEnds[cell] };
+			if (begin == end) { continue; }
+
+			for (unsigned i{ begin }; i < end; i++) {
+				for (unsigned j{ i + 1U }; j < end; j++) {
+					if (m_cellObjects[i]->canInteract(m_cellObjects[j])) { t_out_pairs.emplace_back(m_cellObjects[i], m_cellObjects[j]); }
+				}
+			}
+
+			// With a single row or column some neighbours wrap onto the same cell: visit each only once
+			unsigned neighbours[4];
+			unsigned numNeighbours{ 0U };
+			for (const auto& offset : S_NEIGHBOURS) {
+				if (offset[1] != 0 && m_rows == 1U) { continue; }
+				const unsigned neighbour{ wrapRow(static_cast<int>(row) + offset[1]) * m_columns + wrapColumn(static_cast<int>(column) + offset[0]) };
+				if (neighbour == cell || std::find(neighbours, neighbours + numNeighbours, neighbour) != neighbours + numNeighbours) { continue; }
+				neighbours[numNeighbours++] = neighbour;
+			}
+
+			for (unsigned n{ 0U }; n < numNeighbours; n++) {
+				const unsigned nBegin{ m_cellStarts[neighbours[n]] };
+				const unsigned nEnd{ m_cellEnds[neighbours[n]] };
+				for (unsigned i{ begin }; i < end; i++) {
+					for (unsigned j{ nBegin }; j < nEnd; j++) {
+						if (m_cellObjects[i]->canInteract(m_cellObjects[j])) { t_out_pairs.emplace_back(m_cellObjects[i], m_cellObjects[j]); }
+					}
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+unsigned SpatialGrid::getNumColumns()const { return m_columns; }
+
+////////////////////////////////////////////////////////////
+unsigned SpatialGrid::getNumRows()const { return m_rows; }
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::resize(const float& t_cellSize) {
+	// Two cells in a row would be each other's neighbour on both sides; fall back to a single one
+	m_columns = std::max(1U, static_cast<unsigned>(m_bounds.width / t_cellSize));
+	m_rows = std::max(1U, static_cast<unsigned>(m_bounds.height / t_cellSize));
+	if (m_columns == 2U) { m_columns = 1U; }
+	if (m_rows == 2U) { m_rows = 1U; }
+
+	m_cellWidth = (m_bounds.width > 0.f ? m_bounds.width / m_columns : t_cellSize);
+	m_cellHeight = (m_bounds.height > 0.f ? m_bounds.height / m_rows : t_cellSize);
+}
+
+////////////////////////////////////////////////////////////
+unsigned SpatialGrid::wrapColumn(const int& t_column)const {
+	const int columns{ static_cast<int>(m_columns) };
+	return static_cast<unsigned>(((t_column % columns) + columns) % columns);
+}
+
+////////////////////////////////////////////////////////////
+unsigned SpatialGrid::wrapRow(const int& t_row)const {
+	const int rows{ static_cast<int>(m_rows) };
+	return static_cast<unsigned>(((t_row % rows) + rows) % rows);
+}
+
+////////////////////////////////////////////////////////////
+int SpatialGrid::getColumn(const float& t_x)const { return static_cast<int>(std::floor((t_x - m_bounds.left) / m_cellWidth)); }
+
+////////////////////////////////////////////////////////////
+int SpatialGrid::getRow(const float& t_y)const { return static_cast<int>(std::floor((t_y - m_bounds.top) / m_cellHeight)); }
+
+
+#if defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
+#include <SFML/Graphics/RectangleShape.hpp>
+
+static const sf::RectangleShape S_RECT_SHAPE{ []() {
+	sf::RectangleShape rect;
+	rect.setFillColor({ 0, 0, 0, 0 });
+	rect.setOutlineColor({ 0,0,255, 80 });
+	rect.setOutlineThickness(1.f);
+	return std::move(rect);
+}() };
+
+#endif // defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
+
+
+#if defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
+////////////////////////////////////////////////////////////
+void SpatialGrid::draw(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect) {
+	if (m_cellStarts.empty()) { return; }
+
+	// Only the occupied cells in view, darker the more crowded
+	const int firstColumn{ std::max(getColumn(t_viewRect.left), 0) };
+	const int firstRow{ std::max(getRow(t_viewRect.top), 0) };
+	const int lastColumn{ std::min(getColumn(t_viewRect.left + t_viewRect.width), static_cast<int>(m_columns) - 1) };
+	const int lastRow{ std::min(getRow(t_viewRect.top + t_viewRect.height), static_cast<int>(m_rows) - 1) };
+	auto rect{ S_RECT_SHAPE };
+	rect.setSize({ m_cellWidth, m_cellHeight });
+	for (int row{ firstRow }; row <= lastRow; row++) {
+		for (int column{ firstColumn }; column <= lastColumn; column++) {
+			const unsigned cell{ static_cast<unsigned>(row) * m_columns + static_cast<unsigned>(column) };
+			const unsigned count{ m_cellEnds[cell] - m_cellStarts[cell] };
+			if (count == 0U) { continue; }
+			rect.setFillColor({ 0,0,255, static_cast<sf::Uint8>(std::min(255U, 40U * count)) });
+			rect.setPosition(m_bounds.left + column * m_cellWidth, m_bounds.top + row * m_cellHeight);
+			t_window.draw(rect);
+		}
+	}
+}
+#else
+////////////////////////////////////////////////////////////
+void SpatialGrid::draw(sf::RenderWindow&, const sf::FloatRect&) {}
+#endif // defined(_DEBUG) &&  IS_DRAW_COLLISION_BROAD_PHASE == 1
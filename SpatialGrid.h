@@ -0,0 +1,58 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "BroadPhase_Base.h"
+
+class Collider;
+
+// Uniform grid over a toroidal world: cells on one edge are neighbours of the cells on the opposite edge.
+//	Every object goes in the cell of its center and cells are never smaller than the biggest object,
+//	so touching objects are always in the same or in adjacent cells. Cells are rebuilt in update() with a counting sort.
+class SpatialGrid : public BroadPhase_Base {
+
+	static const float S_MIN_CELL_SIZE;
+	static const float S_MAX_CELLS_PER_OBJECT;
+	static const unsigned NO_CELL;
+
+	sf::FloatRect m_bounds;
+	float m_minCellSize;
+	Objects m_objects; // Slot of every object = its index here
+	std::vector<unsigned> m_objectCells; // Cell of each object, parallel to m_objects; NO_CELL until the next update()
+	std::vector<unsigned> m_cellStarts; // Prefix sums into m_cellObjects, one past the cell count
+	std::vector<unsigned> m_cellEnds; // One past the last object of each cell; removals shrink a cell without moving the others
+	Objects m_cellObjects; // Objects sorted by cell
+	unsigned m_columns;
+	unsigned m_rows;
+	float m_cellWidth;
+	float m_cellHeight;
+
+public:
+	using BroadPhase_Base::getPotentialOverlaps;
+
+	SpatialGrid(const sf::FloatRect& t_bounds, const float& t_minCellSize = S_MIN_CELL_SIZE);
+	const sf::FloatRect& getBounds()const;
+	void setBounds(const sf::FloatRect& t_bounds);
+	void insert(Collider* t_obj);
+	void remove(Collider* t_obj); // Also takes it out of its cell, so queries never see it again
+	void relocate(Collider* t_obj); // Objects are binned again in update() anyway
+	void clear();
+	void update();
+	void getPotentialOverlaps(Objects& t_out_objects, const sf::FloatRect& t_aabb)const; // Wraps around the edges
+	void getCandidatePairs(CandidatePairs& t_out_pairs)const;
+	void draw(sf::RenderWindow& t_window, const sf::FloatRect& t_viewRect);
+
+	unsigned getNumColumns()const;
+	unsigned getNumRows()const;
+
+private:
+	void resize(const float& t_cellSize);
+	unsigned wrapColumn(const int& t_column)const;
+	unsigned wrapRow(const int& t_row)const;
+	int getColumn(const float& t_x)const; // Unwrapped
+	int getRow(const float& t_y)const; // Unwrapped
+};
+
+#endif // !SPATIAL_GRID_H
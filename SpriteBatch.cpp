@@ -0,0 +1,70 @@
+#include "SpriteBatch.h"
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() : m_lastBatch{ 0U }, m_numSprites{ 0U } {}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear() {
+	for (auto& batch : m_batches) { batch.m_vertices.clear(); }
+	m_numSprites = 0U;
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(const sf::Sprite& t_sprite) {
+	// Same corners and texture coordinates as sf::Sprite computes them
+	const sf::IntRect& rect{ t_sprite.getTextureRect() };
+	const float width{ static_cast<float>(std::abs(rect.width)) };
+	const float height{ static_cast<float>(std::abs(rect.height)) };
+	const float left{ static_cast<float>(rect.left) };
+	const float right{ left + rect.width };
+	const float top{ static_cast<float>(rect.top) };
+	const float bottom{ top + rect.height };
+
+	const sf::Transform& transform{ t_sprite.getTransform() };
+	const sf::Color& color{ t_sprite.getColor() };
+	const sf::Vertex topLeft{ transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top) };
+	const sf::Vertex topRight{ transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top) };
+	const sf::Vertex bottomLeft{ transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom) };
+	const sf::Vertex bottomRight{ transform.transformPoint(width, height), color, sf::Vector2f(right, bottom) };
+
+	sf::VertexArray& vertices{ getBatch(t_sprite.getTexture()).m_vertices };
+	vertices.append(topLeft);
+	vertices.append(topRight);
+	vertices.append(bottomLeft);
+	vertices.append(bottomLeft);
+	vertices.append(topRight);
+	vertices.append(bottomRight);
+	m_numSprites++;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getNumSprites()const { return m_numSprites; }
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getNumDrawCalls()const {
+	std::size_t numDrawCalls{ 0U };
+	for (const auto& batch : m_batches) {
+		if (batch.m_vertices.getVertexCount()) { numDrawCalls++; }
+	}
+	return numDrawCalls;
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(sf::RenderTarget& t_target, sf::RenderStates t_states)const {
+	for (const auto& batch : m_batches) {
+		if (!batch.m_vertices.getVertexCount()) { continue; }
+		t_states.texture = batch.m_texture;
+		t_target.draw(batch.m_vertices, t_states);
+	}
+}
+
+////////////////////////////////////////////////////////////
+SpriteBatch::Batch& SpriteBatch::getBatch(const sf::Texture* t_texture) {
+	if (m_lastBatch < m_batches.size() && m_batches[m_lastBatch].m_texture == t_texture) { return m_batches[m_lastBatch]; }
+	for (m_lastBatch = 0U; m_lastBatch < m_batches.size(); m_lastBatch++) {
+		if (m_batches[m_lastBatch].m_texture == t_texture) { return m_batches[m_lastBatch]; }
+	}
+	m_batches.push_back({ t_texture, sf::VertexArray(sf::Triangles) });
+	return m_batches.back();
+}
@@ -0,0 +1,33 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+// Collects the sprites of a frame into one vertex array per texture, two triangles per sprite, so that the whole
+//	frame takes one draw call per texture instead of one per sprite. Like TileMap, but rebuilt every frame.
+class SpriteBatch : public sf::Drawable {
+
+	struct Batch {
+		const sf::Texture* m_texture;
+		sf::VertexArray m_vertices;
+	};
+
+	std::vector<Batch> m_batches; // In the order their textures were first added; kept between frames with their memory
+	std::size_t m_lastBatch; // Consecutive sprites mostly share a texture
+	std::size_t m_numSprites;
+
+public:
+	SpriteBatch();
+	void clear(); // Empties every batch, keeping its memory
+	void add(const sf::Sprite& t_sprite); // Its transform, texture rect and color, as they are now
+	std::size_t getNumSprites()const;
+	std::size_t getNumDrawCalls()const;
+
+	virtual void draw(sf::RenderTarget& t_target, sf::RenderStates t_states)const;
+
+private:
+	Batch& getBatch(const sf::Texture* t_texture);
+};
+
+#endif // !SPRITE_BATCH_H
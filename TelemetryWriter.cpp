@@ -0,0 +1,359 @@
+#include "TelemetryWriter.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+static const std::uint32_t S_MAGIC{ 0x4D4C5447U }; // "GTLM"
+static const std::uint32_t S_VERSION{ 1U };
+static const std::size_t S_BLOCK_TICKS{ 256U }; // Ticks recorded before the block goes to the background thread
+static const std::size_t S_MAX_SAMPLES{ 64U }; // Organisms sampled per sampling tick
+
+// Store fields averaged every tick and written for the sampled organisms
+static const std::array<OrganismField, 11> S_TRACKED_FIELDS{
+	OrganismField::Energy, OrganismField::Mass, OrganismField::Age, OrganismField::MaxEnergy, OrganismField::DigestiveEfficiency,
+	OrganismField::RestingMetabolicRate, OrganismField::MovementSpeed, OrganismField::TurningSpeed,
+	OrganismField::FoodDetectionRange, OrganismField::Lifespan, OrganismField::Size };
+static const std::array<const char*, 11> S_TRACKED_NAMES{
+	"energy", "mass", "age", "max_energy", "digestive_efficiency",
+	"resting_metabolic_rate", "movement_speed", "turning_speed",
+	"food_detection_range", "lifespan", "size" };
+
+static const std::size_t S_TICK_INTEGERS{ 4U }; // Tick, population, dead, food
+static const std::size_t S_ORGANISM_INTEGERS{ 2U }; // Tick, slot
+static const std::string S_CSV_EXTENSION{ ".csv" };
+
+
+// -------------------------------------------------------- ENCODING	-----------------------------------------
+
+////////////////////////////////////////////////////////////
+static std::string getCsvHeader(bool t_isTicks) {
+	std::string header{ t_isTicks ? "tick,population,dead,food,energy_pool" : "tick,slot" };
+	for (const auto& name : S_TRACKED_NAMES) {
+		header += t_isTicks ? ",mean_" : ",";
+		header += name;
+	}
+	return header;
+}
+
+////////////////////////////////////////////////////////////
+static bool isCsvFileName(const std::string& t_fileName) {
+	return t_fileName.size() > S_CSV_EXTENSION.size() &&
+		t_fileName.compare(t_fileName.size() - S_CSV_EXTENSION.size(), S_CSV_EXTENSION.size(), S_CSV_EXTENSION) == 0;
+}
+
+////////////////////////////////////////////////////////////
+static void initBlock(TelemetryBlock& t_block) {
+	t_block.m_ticks.m_integers.resize(S_TICK_INTEGERS);
+	t_block.m_ticks.m_floats.resize(1U + S_TRACKED_FIELDS.size()); // Energy pool, then the means
+	t_block.m_organisms.m_integers.resize(S_ORGANISM_INTEGERS);
+	t_block.m_organisms.m_floats.resize(S_TRACKED_FIELDS.size());
+}
+
+////////////////////////////////////////////////////////////
+static void writeCsv(std::ostream& t_out, const TelemetryTable& t_table) {
+	for (std::size_t row{ 0U }; row < t_table.size(); row++) {
+		bool isFirst{ true };
+		for (const auto& column : t_table.m_integers) {
+			t_out << (isFirst ? "" : ",") << column[row];
+			isFirst = false;
+		}
+		for (const auto& column : t_table.m_floats) { t_out << ',' << column[row]; }
+		t_out << '\n';
+	}
+}
+
+////////////////////////////////////////////////////////////
+static void writeVarint(std::string& t_out, std::uint64_t t_value) {
+	while (t_value >= 0x80U) {
+		t_out.push_back(static_cast<char>((t_value & 0x7FU) | 0x80U));
+		t_value >>= 7;
+	}
+	t_out.push_back(static_cast<char>(t_value));
+}
+
+////////////////////////////////////////////////////////////
+static bool readVarint(const char*& t_it, const char* t_end, std::uint64_t& t_out_value) {
+	t_out_value = 0U;
+	for (unsigned shift{ 0U }; t_it != t_end && shift < 64U; shift += 7U) {
+		const std::uint8_t byte{ static_cast<std::uint8_t>(*t_it++) };
+		t_out_value |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+		if (!(byte & 0x80U)) { return true; }
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+static void encodeTable(std::string& t_out, std::string& t_scratch, const TelemetryTable& t_table) {
+	writeVarint(t_out, t_table.size());
+	for (const auto& column : t_table.m_integers) {
+		t_scratch.clear();
+		std::uint64_t previous{ 0U };
+		for (const auto& value : column) {
+			const std::int64_t delta{ static_cast<std::int64_t>(value - previous) };
+			writeVarint(t_scratch, (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63)); // Zigzag: small negative deltas stay small
+			previous = value;
+		}
+		writeVarint(t_out, t_scratch.size());
+		t_out += t_scratch;
+	}
+	for (const auto& column : t_table.m_floats) {
+		t_scratch.clear();
+		std::uint32_t previous{ 0U };
+		for (const auto& value : column) {
+			std::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			writeVarint(t_scratch, bits ^ previous); // Close values share sign, exponent and the top of the mantissa: leading zeros
+			previous = bits;
+		}
+		writeVarint(t_out, t_scratch.size());
+		t_out += t_scratch;
+	}
+}
+
+////////////////////////////////////////////////////////////
+static bool decodeTable(const char*& t_it, const char* t_end, TelemetryTable& t_out_table) {
+	std::uint64_t numRows{ 0U };
+	if (!readVarint(t_it, t_end, numRows)) { return false; }
+	auto decodeColumn{ [&t_it, t_end, &numRows](auto&& t_decode) {
+		std::uint64_t numBytes{ 0U };
+		if (!readVarint(t_it, t_end, numBytes) || numBytes > static_cast<std::uint64_t>(t_end - t_it)) { return false; }
+		const char* columnEnd{ t_it + numBytes };
+		for (std::uint64_t row{ 0U }; row < numRows; row++) {
+			std::uint64_t value{ 0U };
+			if (!readVarint(t_it, columnEnd, value)) { return false; }
+			t_decode(value);
+		}
+		return t_it == columnEnd;
+	} };
+
+	for (auto& column : t_out_table.m_integers) {
+		column.clear();
+		std::uint64_t previous{ 0U };
+		if (!decodeColumn([&column, &previous](const std::uint64_t& t_value) {
+			previous += (t_value >> 1) ^ (~(t_value & 1U) + 1U);
+			column.push_back(previous);
+		})) { return false; }
+	}
+	for (auto& column : t_out_table.m_floats) {
+		column.clear();
+		std::uint32_t previous{ 0U };
+		if (!decodeColumn([&column, &previous](const std::uint64_t& t_value) {
+			previous ^= static_cast<std::uint32_t>(t_value);
+			float value;
+			std::memcpy(&value, &previous, sizeof(value));
+			column.push_back(value);
+		})) { return false; }
+	}
+	return true;
+}
+
+// -------------------------------------------------------- encoding	-----------------------------------------
+
+
+////////////////////////////////////////////////////////////
+std::size_t TelemetryTable::size()const { return m_integers.empty() ? 0U : m_integers.front().size(); }
+
+////////////////////////////////////////////////////////////
+void TelemetryTable::clear() {
+	for (auto& column : m_integers) { column.clear(); }
+	for (auto& column : m_floats) { column.clear(); }
+}
+
+
+////////////////////////////////////////////////////////////
+TelemetryWriter::TelemetryWriter() : m_isCsv{ false }, m_sampleInterval{ 1U }, m_isRunning{ false } { initBlock(m_block); }
+
+////////////////////////////////////////////////////////////
+TelemetryWriter::~TelemetryWriter() { close(); }
+
+////////////////////////////////////////////////////////////
+bool TelemetryWriter::open(const std::string& t_fileName, const unsigned& t_sampleInterval) {
+	close();
+	m_isCsv = isCsvFileName(t_fileName);
+	m_sampleInterval = std::max(t_sampleInterval, 1U);
+
+	m_ticksFile.open(t_fileName, std::ios::binary | std::ios::trunc);
+	if (m_isCsv) {
+		m_organismsFile.open(t_fileName.substr(0, t_fileName.size() - S_CSV_EXTENSION.size()) + ".organisms" + S_CSV_EXTENSION, std::ios::binary | std::ios::trunc);
+		m_ticksFile << getCsvHeader(true) << '\n' << std::setprecision(std::numeric_limits<float>::max_digits10);
+		m_organismsFile << getCsvHeader(false) << '\n' << std::setprecision(std::numeric_limits<float>::max_digits10);
+	}
+	else {
+		// The column names go first, so a decoder can tell whether it reads the same schema
+		std::string header;
+		header.append(reinterpret_cast<const char*>(&S_MAGIC), sizeof(S_MAGIC));
+		header.append(reinterpret_cast<const char*>(&S_VERSION), sizeof(S_VERSION));
+		for (bool isTicks : { true, false }) {
+			const std::string names{ getCsvHeader(isTicks) };
+			writeVarint(header, names.size());
+			header += names;
+		}
+		m_ticksFile.write(header.data(), header.size());
+	}
+	if (!m_ticksFile || (m_isCsv && !m_organismsFile)) {
+		std::cerr << "@ ERROR: TelemetryWriter::open: Could not open " << t_fileName << "!" << std::endl;
+		m_ticksFile.close();
+		m_organismsFile.close();
+		return false;
+	}
+
+	m_isRunning = true;
+	m_writer = std::thread(&TelemetryWriter::writerLoop, this);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void TelemetryWriter::close() {
+	if (!isOpen()) { return; }
+	flush();
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_isRunning = false;
+	}
+	m_condition.notify_one();
+	m_writer.join(); // Drains the queue first
+	m_ticksFile.close();
+	m_organismsFile.close();
+}
+
+////////////////////////////////////////////////////////////
+bool TelemetryWriter::isOpen()const { return m_writer.joinable(); }
+
+////////////////////////////////////////////////////////////
+void TelemetryWriter::record(const unsigned long long& t_tick, const OrganismStore& t_store, const float& t_energyPool, const unsigned& t_numFood) {
+	std::array<const float*, S_TRACKED_FIELDS.size()> columns;
+	for (std::size_t i{ 0U }; i < columns.size(); i++) { columns[i] = t_store.getColumn(S_TRACKED_FIELDS[i]).data(); }
+
+	std::array<double, S_TRACKED_FIELDS.size()> sums{};
+	std::uint64_t population{ 0U };
+	std::uint64_t dead{ 0U };
+	const std::size_t numRows{ t_store.size() };
+	for (unsigned row{ 0U }; row < numRows; row++) {
+		if (!t_store.isSpawned(row)) { continue; }
+		if (t_store.isDead(row)) {
+			dead++;
+			continue;
+		}
+		population++;
+		for (std::size_t i{ 0U }; i < sums.size(); i++) { sums[i] += columns[i][row]; }
+	}
+
+	TelemetryTable& ticks{ m_block.m_ticks };
+	ticks.m_integers[0].push_back(t_tick);
+	ticks.m_integers[1].push_back(population);
+	ticks.m_integers[2].push_back(dead);
+	ticks.m_integers[3].push_back(t_numFood);
+	ticks.m_floats[0].push_back(t_energyPool);
+	for (std::size_t i{ 0U }; i < sums.size(); i++) {
+		ticks.m_floats[i + 1U].push_back(population ? static_cast<float>(sums[i] / population) : 0.f);
+	}
+
+	// Evenly spread samples of the live organisms, in slot order
+	if (population && t_tick % m_sampleInterval == 0U) {
+		TelemetryTable& organisms{ m_block.m_organisms };
+		const std::uint64_t stride{ std::max<std::uint64_t>(population / S_MAX_SAMPLES, 1U) };
+		std::uint64_t alive{ 0U };
+		for (unsigned row{ 0U }; row < numRows; row++) {
+			if (!t_store.isSpawned(row) || t_store.isDead(row) || alive++ % stride) { continue; }
+			organisms.m_integers[0].push_back(t_tick);
+			organisms.m_integers[1].push_back(row);
+			for (std::size_t i{ 0U }; i < columns.size(); i++) { organisms.m_floats[i].push_back(columns[i][row]); }
+		}
+	}
+
+	if (ticks.size() >= S_BLOCK_TICKS) { flush(); }
+}
+
+////////////////////////////////////////////////////////////
+bool TelemetryWriter::convertToCsv(const std::string& t_inFileName, const std::string& t_outFileName) {
+	std::ifstream in{ t_inFileName, std::ios::binary };
+	const std::string data{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+	const char* it{ data.data() };
+	const char* end{ data.data() + data.size() };
+
+	std::uint32_t magic{ 0U };
+	std::uint32_t version{ 0U };
+	if (data.size() >= sizeof(magic) + sizeof(version)) {
+		std::memcpy(&magic, it, sizeof(magic));
+		std::memcpy(&version, it + sizeof(magic), sizeof(version));
+		it += sizeof(magic) + sizeof(version);
+	}
+	bool isValid{ magic == S_MAGIC && version == S_VERSION };
+	for (bool isTicks : { true, false }) {
+		std::uint64_t size{ 0U };
+		isValid = isValid && readVarint(it, end, size) && size <= static_cast<std::uint64_t>(end - it) &&
+			std::string(it, static_cast<std::size_t>(size)) == getCsvHeader(isTicks);
+		if (isValid) { it += size; }
+	}
+	if (!isValid) {
+		std::cerr << "@ ERROR: TelemetryWriter::convertToCsv: " << t_inFileName << " is missing or not telemetry of this version!" << std::endl;
+		return false;
+	}
+
+	if (!isCsvFileName(t_outFileName)) {
+		std::cerr << "@ ERROR: TelemetryWriter::convertToCsv: " << t_outFileName << " has to end in .csv!" << std::endl;
+		return false;
+	}
+	TelemetryWriter csv;
+	if (!csv.open(t_outFileName)) { return false; }
+	while (it != end) {
+		if (!decodeTable(it, end, csv.m_block.m_ticks) || !decodeTable(it, end, csv.m_block.m_organisms)) {
+			std::cerr << "@ ERROR: TelemetryWriter::convertToCsv: " << t_inFileName << " is truncated!" << std::endl;
+			return false;
+		}
+		csv.flush();
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void TelemetryWriter::flush() {
+	if (!m_block.m_ticks.size() && !m_block.m_organisms.size()) { return; }
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_queue.push_back(std::move(m_block));
+		m_block = TelemetryBlock(); // Without columns after the move
+		if (!m_freeBlocks.empty()) {
+			m_block = std::move(m_freeBlocks.back());
+			m_freeBlocks.pop_back();
+		}
+	}
+	initBlock(m_block);
+	m_condition.notify_one();
+}
+
+////////////////////////////////////////////////////////////
+void TelemetryWriter::writerLoop() {
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	while (true) {
+		m_condition.wait(lock, [this]() { return !m_queue.empty() || !m_isRunning; });
+		if (m_queue.empty()) { return; } // Closed and drained
+
+		TelemetryBlock block{ std::move(m_queue.front()) };
+		m_queue.pop_front();
+		lock.unlock();
+		writeBlock(block);
+		block.m_ticks.clear();
+		block.m_organisms.clear();
+		lock.lock();
+		m_freeBlocks.push_back(std::move(block));
+	}
+}
+
+////////////////////////////////////////////////////////////
+void TelemetryWriter::writeBlock(const TelemetryBlock& t_block) {
+	if (m_isCsv) {
+		writeCsv(m_ticksFile, t_block.m_ticks);
+		writeCsv(m_organismsFile, t_block.m_organisms);
+		return;
+	}
+	std::string encoded;
+	std::string scratch;
+	encodeTable(encoded, scratch, t_block.m_ticks);
+	encodeTable(encoded, scratch, t_block.m_organisms);
+	m_ticksFile.write(encoded.data(), encoded.size());
+}
@@ -0,0 +1,68 @@
+#ifndef TELEMETRY_WRITER_H
+#define TELEMETRY_WRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OrganismStore.h"
+
+// Rows recorded since the last flush, column by column
+struct TelemetryTable {
+	std::vector<std::vector<std::uint64_t>> m_integers;
+	std::vector<std::vector<float>> m_floats;
+
+	std::size_t size()const;
+	void clear(); // Keeps the memory of the columns
+};
+
+struct TelemetryBlock {
+	TelemetryTable m_ticks; // One row of population aggregates per tick
+	TelemetryTable m_organisms; // Per-organism rows, sampled every few ticks
+};
+
+// Streams run telemetry to disk. The simulation thread only fills column buffers; encoding and file IO run on a
+//	background thread, one block of ticks at a time.
+//	Files ending in .csv are written as two CSV files (ticks, then <name>.organisms.csv); anything else is a single
+//	compressed columnar file: per block and column, integers as zigzag deltas and floats as XORs with the previous
+//	row, both as varints, so slowly changing columns take a byte or two per row. convertToCsv() decodes it.
+class TelemetryWriter {
+
+	std::ofstream m_ticksFile;
+	std::ofstream m_organismsFile; // CSV only
+	bool m_isCsv;
+	unsigned m_sampleInterval; // Ticks between two per-organism samples
+
+	TelemetryBlock m_block; // Being recorded
+	std::deque<TelemetryBlock> m_queue; // Waiting to be written
+	std::vector<TelemetryBlock> m_freeBlocks; // Written, kept for their memory
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::thread m_writer;
+	bool m_isRunning;
+
+	TelemetryWriter(const TelemetryWriter& t_rhs) = delete;
+
+public:
+	TelemetryWriter();
+	~TelemetryWriter();
+	bool open(const std::string& t_fileName, const unsigned& t_sampleInterval = 30U);
+	void close(); // Writes whatever was recorded and waits for the background thread
+	bool isOpen()const;
+
+	// Aggregates the live organisms of the store in one pass over its columns, and samples some of them
+	void record(const unsigned long long& t_tick, const OrganismStore& t_store, const float& t_energyPool, const unsigned& t_numFood);
+
+	static bool convertToCsv(const std::string& t_inFileName, const std::string& t_outFileName);
+
+private:
+	void flush(); // Hands the current block to the background thread
+	void writerLoop();
+	void writeBlock(const TelemetryBlock& t_block);
+};
+
+#endif // !TELEMETRY_WRITER_H
@@ -1,20 +1,15 @@
 #include <cassert>
+#include <cmath>
 #include "Trait.h"
+#include "TraitCollection.h"
 #include "Organism.h"
-#include "SharedContext.h"
-#include "RandomGenerator.h"
 
 
-static TraitCallback bind(TraitFunctor t_functor) { return std::bind(t_functor, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3); }
-
 // Used some macros to cut down the space needed for the table initializer
 #define TB Trait_Base						// T.B	  = Trait Base
-#define MT std::make_tuple					// M.T.	  = Make Tuple
 #define TID TraitId							// T.I.D  = Trait ID
-#define	MF std::make_unique<Trait_Float>	// M.K.   = Make Float
-#define MC std::make_unique<Trait_Color>	// M.C.   = Make Color
 #define TEF TraitEffectTime					// T.E.T. = Trait Effect Time
-#define SFC sf::Color						// S.F.C. = Simple Fast Color (SFML)
+#define TT TraitType						// T.T.   = Trait Type
 
 static const bool NON_VITAL_TRAIT{ false };
 static const bool VITAL_TRAIT{ true };
@@ -22,92 +17,63 @@ static const bool INACTIVE_TRAIT{ false };
 static const bool ACTIVE_TRAIT{ true };
 static const float ALWAYS_INHERITED{ 1.f };
 
-// Enum identifiers for std::get
-enum { STRING, CALLBACK, EFFECT_TIME };
-// ------------------------------------------------------- TRAIT BASE ------------------------------------------------------- 
+// ------------------------------------------------------- TRAIT BASE -------------------------------------------------------
 
 ////////////////////////////////////////////////////////////
-const std::string& Trait_Base::getTraitName(const TraitId& t_id) {
-	static const std::string emptyStr{ "" };
-	auto it{ s_traitNamesAndCallbacks.find(t_id) };
-	return (it != s_traitNamesAndCallbacks.cend() ? std::get<STRING>(it->second) : emptyStr);
+const TraitInfo& Trait_Base::getTraitInfo(const TraitId& t_id) {
+	assert(t_id != TraitId::INVALID_TRAIT_ID && t_id != TraitId::TRAIT_COUNT && "Trait_Base::getTraitInfo(const TraitId&): Not a trait id!");
+	return s_traits[static_cast<std::size_t>(t_id)];
 }
 
 ////////////////////////////////////////////////////////////
-TraitCallback Trait_Base::getTraitCallback(const TraitId& t_id) {
-	assert(t_id != TraitId::INVALID_TRAIT_ID && "Trait_Base::getTraitCallback(const TraitId&): INVALID_TRAIT_ID is not a trait id!");
-	return std::get<CALLBACK>(s_traitNamesAndCallbacks.at(t_id));
+const std::string& Trait_Base::getTraitName(const TraitId& t_id) {
+	static const std::string emptyStr{ "" };
+	if (t_id == TraitId::INVALID_TRAIT_ID || t_id == TraitId::TRAIT_COUNT) { return emptyStr; }
+	return getTraitInfo(t_id).m_name;
 }
 
 ////////////////////////////////////////////////////////////
-const TraitEffectTime& Trait_Base::getTraitEffectTime(const TraitId& t_id) {
-	assert(t_id != TraitId::INVALID_TRAIT_ID && "Trait_Base::getTraitEffectTime(const TraitId&): INVALID_TRAIT_ID is not a trait id!");
-	return std::get<EFFECT_TIME>(s_traitNamesAndCallbacks.at(t_id));
-}
-
+TraitFunctor Trait_Base::getTraitCallback(const TraitId& t_id) { return getTraitInfo(t_id).m_effect; }
 
 ////////////////////////////////////////////////////////////
-bool Trait_Base::isTraitVital(const TraitId& t_id) { return s_vitalTraits.find(t_id) != s_vitalTraits.cend(); }
+const TraitEffectTime& Trait_Base::getTraitEffectTime(const TraitId& t_id) { return getTraitInfo(t_id).m_effectTime; }
 
 ////////////////////////////////////////////////////////////
-const TraitSet& Trait_Base::getVitalTraits() { return s_vitalTraits; }
+bool Trait_Base::isTraitVital(const TraitId& t_id) { return getTraitInfo(t_id).m_isVital; }
 
 ////////////////////////////////////////////////////////////
-bool Trait_Base::isTraitFloat(const TraitId& t_id) { return s_floatTraits.find(t_id) != s_floatTraits.cend(); }
+bool Trait_Base::isTraitFloat(const TraitId& t_id) { return getTraitInfo(t_id).m_type == TraitType::Float; }
 
 ////////////////////////////////////////////////////////////
-bool Trait_Base::isTraitColor(const TraitId& t_id) { return s_colorTraits.find(t_id) != s_colorTraits.cend(); }
+bool Trait_Base::isTraitColor(const TraitId& t_id) { return getTraitInfo(t_id).m_type == TraitType::Color; }
 
 ////////////////////////////////////////////////////////////
 const float& Trait_Base::getTraitStdDev() { return s_traitsStdDev; }
 
 ////////////////////////////////////////////////////////////
-Trait_Base::Trait_Base(const TraitId& t_id, bool t_isActive, const float& t_inheritChance) :
-	m_id{ t_id },
-	m_isActive{ t_isActive },
-	m_inheritChance{ t_inheritChance },
-	m_effectTime{ getTraitEffectTime(t_id) },
-	m_effect{ getTraitCallback(t_id) }{}
+const float& Trait_Base::getMinTraitFactor() { return s_minTraitFactor; }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::update(Organism* t_owner, const float& t_elapsed) {
-	m_effect(this, t_owner, t_elapsed);
+const TraitCollection& Trait_Base::getDefaultTraits() {
+	static const sf::Color S_GREEN{ 0,255,0,255 };
+	static const TraitCollection S_DEFAULT_TRAITS{ []() {
+		TraitCollection tmp;
+		//				 id							isActive	 inheritChance		value
+		tmp.addTrait(TID::MaxEnergy,			ACTIVE_TRAIT, ALWAYS_INHERITED, 500.f);
+		tmp.addTrait(TID::DigestiveEfficiency,	ACTIVE_TRAIT, ALWAYS_INHERITED, 0.5f);
+		tmp.addTrait(TID::RestingMetabolicRate,	ACTIVE_TRAIT, ALWAYS_INHERITED, 1.f);
+		tmp.addTrait(TID::MovementSpeed,		ACTIVE_TRAIT, ALWAYS_INHERITED, 20.f);
+		tmp.addTrait(TID::TurningSpeed,			ACTIVE_TRAIT, ALWAYS_INHERITED, 20.f);
+		tmp.addTrait(TID::FoodDetectionRange,	ACTIVE_TRAIT, ALWAYS_INHERITED, 100.f);
+		tmp.addTrait(TID::Lifespan,				ACTIVE_TRAIT, ALWAYS_INHERITED, 200.f);
+		tmp.addTrait(TID::Size,					ACTIVE_TRAIT, ALWAYS_INHERITED, 1.f);
+		tmp.addTrait(TID::Color,				ACTIVE_TRAIT, ALWAYS_INHERITED, S_GREEN);
+		return tmp;
+	}() }; // Built on first use, after the trait table
+	return S_DEFAULT_TRAITS;
 }
 
-////////////////////////////////////////////////////////////
-TraitPtr Trait_Base::cloneDefaultTrait(const TraitId& t_id) {
-	auto it{ s_defaultTraits.find(t_id) };
-	return (it != s_defaultTraits.cend() ? std::move(it->second->clone()) : nullptr);
-}
-
-////////////////////////////////////////////////////////////
-TraitPtr Trait_Base::reproduceDefaultTrait(SharedContext& t_context, const TraitId& t_id) {
-	auto it{ s_defaultTraits.find(t_id) };
-	return (it != s_defaultTraits.cend() ? std::move(it->second->reproduce(t_context)) : nullptr);
-}
-
-////////////////////////////////////////////////////////////
-const TraitId& Trait_Base::getId()const { return m_id; }
-
-////////////////////////////////////////////////////////////
-bool Trait_Base::getIsActive()const { return m_isActive; }
-
-////////////////////////////////////////////////////////////
-void Trait_Base::setIsActive(bool t_isActive) { m_isActive = t_isActive; }
-
-////////////////////////////////////////////////////////////
-bool Trait_Base::getIsVital()const { return s_vitalTraits.find(m_id) != s_vitalTraits.cend(); }
-
-////////////////////////////////////////////////////////////
-const float& Trait_Base::getInheritChance()const { return m_inheritChance; }
-
-////////////////////////////////////////////////////////////
-void Trait_Base::setInheritChance(const float& t_inheritChance) { m_inheritChance = t_inheritChance; }
-
-////////////////////////////////////////////////////////////
-const TraitEffectTime& Trait_Base::getEffectTime()const { return getTraitEffectTime(m_id); }
-
-// ---------- STATIC MEMBERS ---------- 
+// ---------- STATIC MEMBERS ----------
 ////////////////////////////////////////////////////////////
 const float Trait_Base::s_minTraitFactor{ 0.2f };
 
@@ -115,172 +81,79 @@ const float Trait_Base::s_minTraitFactor{ 0.2f };
 const float Trait_Base::s_traitsStdDev{ 0.3f };
 
 ////////////////////////////////////////////////////////////
-const TraitSet  Trait_Base::s_vitalTraits{
-	TraitId::MaxEnergy,
-	TraitId::DigestiveEfficiency,
-	TraitId::RestingMetabolicRate,
-	TraitId::MovementSpeed,
-	TraitId::TurningSpeed,
-	TraitId::Lifespan,
-	TraitId::Color,
-	TraitId::Size,
-};
-
-////////////////////////////////////////////////////////////
-const TraitSet Trait_Base::s_floatTraits{
-	TraitId::MaxEnergy,
-	TraitId::DigestiveEfficiency,
-	TraitId::RestingMetabolicRate,
-	TraitId::MovementSpeed,
-	TraitId::TurningSpeed,
-	TraitId::FoodDetectionRange,
-	TraitId::Lifespan,
-	TraitId::Size
-};
-
-////////////////////////////////////////////////////////////
-const TraitSet Trait_Base::s_colorTraits{
-	TraitId::Color
-};
-
-////////////////////////////////////////////////////////////
-const TraitTable Trait_Base::s_traitNamesAndCallbacks{
-	//	key							string							callback								tratiEffectTime
-		{TID::MaxEnergy,			{"Trait_MaxEnergy",				bind(TB::TraitFn_MaxEnergy),			TEF::OnConstruction}},
-		{TID::DigestiveEfficiency,	{"Trait_DigestiveEfficiency",	bind(TB::TraitFn_DigestiveEfficiency),	TEF::OnConstruction}},
-		{TID::RestingMetabolicRate,	{"Trait_RestingMetabolicRate",	bind(TB::TraitFn_RestingMetabolicRate),	TEF::OnConstruction}},
-		{TID::MovementSpeed,		{"Trait_MovementSpeed",			bind(TB::TraitFn_MovementSpeed),		TEF::OnConstruction}},
-		{TID::TurningSpeed,			{"Trait_TurningSpeed",			bind(TB::TraitFn_TurningSpeed),			TEF::OnConstruction}},
-		{TID::Lifespan,				{"Trait_Lifespan",				bind(TB::TraitFn_Lifespan),				TEF::OnConstruction}},
-		{TID::Size,					{"Trait_Size",					bind(TB::TraitFn_Size),					TEF::OnConstruction}},
-		{TID::Color,				{"Trait_Color",					bind(TB::TraitFn_Color),				TEF::OnConstruction}}
-};
-
-////////////////////////////////////////////////////////////
-
-static const sf::Color S_GREEN{ 0,255,0,255 };
-
-////////////////////////////////////////////////////////////
-const TraitMap Trait_Base::s_defaultTraits{ []() {
-	TraitMap tmp;
-	//				 key						id							isActive	 inheritChance		value
-	tmp.emplace(TID::MaxEnergy,				MF(TID::MaxEnergy,				ACTIVE_TRAIT, ALWAYS_INHERITED, 500.f));
-	tmp.emplace(TID::DigestiveEfficiency,	MF(TID::DigestiveEfficiency,	ACTIVE_TRAIT, ALWAYS_INHERITED, 0.5f));
-	tmp.emplace(TID::RestingMetabolicRate,	MF(TID::RestingMetabolicRate,	ACTIVE_TRAIT, ALWAYS_INHERITED, 1.f));
-	tmp.emplace(TID::MovementSpeed,			MF(TID::MovementSpeed,			ACTIVE_TRAIT, ALWAYS_INHERITED, 20.f));
-	tmp.emplace(TID::TurningSpeed,			MF(TID::TurningSpeed,			ACTIVE_TRAIT, ALWAYS_INHERITED, 20.f));
-	tmp.emplace(TID::Lifespan,				MF(TID::Lifespan,				ACTIVE_TRAIT, ALWAYS_INHERITED, 200.f));
-	tmp.emplace(TID::Size,					MF(TID::Size,					ACTIVE_TRAIT, ALWAYS_INHERITED, 1.f));
-	tmp.emplace(TID::Color,					MC(TID::Color,					ACTIVE_TRAIT, ALWAYS_INHERITED, S_GREEN));
-	return std::move(tmp);
-}() }; // Initialized with a lambda because of unique_ptr
-
+const TraitTable Trait_Base::s_traits{ []() {
+	TraitTable tmp;
+	auto set{ [&tmp](const TraitId& t_id, TraitInfo t_info) { tmp[static_cast<std::size_t>(t_id)] = std::move(t_info); } };
+	//	id							name							callback								effectTime			type		isVital
+	set(TID::MaxEnergy,				{"Trait_MaxEnergy",				&TB::TraitFn_MaxEnergy,					TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::DigestiveEfficiency,	{"Trait_DigestiveEfficiency",	&TB::TraitFn_DigestiveEfficiency,		TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::RestingMetabolicRate,	{"Trait_RestingMetabolicRate",	&TB::TraitFn_RestingMetabolicRate,		TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::MovementSpeed,			{"Trait_MovementSpeed",			&TB::TraitFn_MovementSpeed,				TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::TurningSpeed,			{"Trait_TurningSpeed",			&TB::TraitFn_TurningSpeed,				TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::FoodDetectionRange,	{"Trait_FoodDetectionRange",	&TB::TraitFn_FoodDetectionRange,		TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::Lifespan,				{"Trait_Lifespan",				&TB::TraitFn_Lifespan,					TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::Size,					{"Trait_Size",					&TB::TraitFn_Size,						TEF::OnConstruction, TT::Float,	VITAL_TRAIT});
+	set(TID::Color,					{"Trait_Color",					&TB::TraitFn_Color,						TEF::OnConstruction, TT::Color,	VITAL_TRAIT});
+	return tmp;
+}() };
 
 // ------------------------------------------------------- trait base --------------------------------------------------------
-// ------------------------------------------------------- TRAIT FLOAT ------------------------------------------------------- 
-
-////////////////////////////////////////////////////////////
-Trait_Float::Trait_Float(const TraitId& t_id, bool t_isActive, const float& t_inheritChance, const float& t_value) :
-	Trait_Base(t_id, t_isActive, t_inheritChance), m_value{ t_value }
-{}
 
-////////////////////////////////////////////////////////////
-TraitPtr Trait_Float::clone() const { return std::make_unique<Trait_Float>(m_id, m_isActive, m_inheritChance, m_value); }
-
-////////////////////////////////////////////////////////////
-TraitPtr Trait_Float::reproduce(SharedContext& t_context)const {
-	float factor{ t_context.m_rng->normalDisttribution(1.f,s_traitsStdDev) };
-	if (factor < s_minTraitFactor) { factor = s_minTraitFactor; }
-	return std::make_unique<Trait_Float>(m_id, m_isActive, m_inheritChance, m_value * factor);
-}
-////////////////////////////////////////////////////////////
-const float& Trait_Float::getValue() const { return m_value; }
 
-////////////////////////////////////////////////////////////
-void Trait_Float::setValue(const float& t_value) { m_value = t_value; }
 
-// ------------------------------------------------------- trait float ------------------------------------------------------- 
-// ------------------------------------------------------- TRAIT COLOR ------------------------------------------------------- 
 
-////////////////////////////////////////////////////////////
-Trait_Color::Trait_Color(const TraitId& t_id, bool t_isActive, const float& t_inheritChance, const sf::Color& t_color) :
-	Trait_Base(t_id, t_isActive, t_inheritChance),
-	m_color{ t_color }
-{}
+// ------------------------------------------------------------- TRAITS' IMPLEMENTATION ------------------------------------------------------------------
 
-////////////////////////////////////////////////////////////
-TraitPtr Trait_Color::clone()const { return std::make_unique<Trait_Color>(m_id, m_isActive, m_inheritChance, m_color); }
 
 ////////////////////////////////////////////////////////////
-TraitPtr Trait_Color::reproduce(SharedContext& t_context)const {
-	float hueFactor{ t_context.m_rng->normalDisttribution(1.f,s_traitsStdDev) }; // For colors, the normal distribution changes the hue value
-	auto hsl{ HSL::TurnToHSL(m_color) };
-	hsl.Hue *= hueFactor;
-	return std::make_unique<Trait_Color>(m_id, m_isActive, m_inheritChance, hsl.TurnToRGB());
+void Trait_Base::TraitFn_MaxEnergy(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	float e{ t_traits.getValue(TraitId::MaxEnergy) };
+	t_organism->field(OrganismField::MaxEnergy) = e;
+	t_organism->field(OrganismField::Energy) = e;
 }
 
-
-
-////////////////////////////////////////////////////////////
-const sf::Color& Trait_Color::getColor() const { return m_color; }
-
-////////////////////////////////////////////////////////////
-void Trait_Color::setColor(const sf::Color& t_color) { m_color = t_color; }
-
-// ------------------------------------------------------- trait color ------------------------------------------------------- 
-
-
-
-
-
-
-// ------------------------------------------------------------- TRAITS' IMPLEMENTATION ------------------------------------------------------------------
-
-
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_MaxEnergy(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	float e{ dynamic_cast<Trait_Float*>(t_trait)->getValue() };
-	t_organism->m_trait_maxEnergy = e;
-	t_organism->m_energy = e;
+void Trait_Base::TraitFn_DigestiveEfficiency(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	t_organism->field(OrganismField::DigestiveEfficiency) = t_traits.getValue(TraitId::DigestiveEfficiency);
 }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_DigestiveEfficiency(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	t_organism->m_trait_digestiveEfficiency = dynamic_cast<Trait_Float*>(t_trait)->getValue();
+void Trait_Base::TraitFn_RestingMetabolicRate(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	t_organism->field(OrganismField::RestingMetabolicRate) = t_traits.getValue(TraitId::RestingMetabolicRate);
+	t_organism->m_rmr = t_organism->getRestingMetabolicRate(); // Also included in size trait to not enforce a loading order
 }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_RestingMetabolicRate(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	t_organism->m_trait_restingMetabolicRate = dynamic_cast<Trait_Float*>(t_trait)->getValue();
-	t_organism->m_rmr = t_organism->m_mass * t_organism->m_trait_restingMetabolicRate; // Also included in size trait to not enforce a loading order
+void Trait_Base::TraitFn_MovementSpeed(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	t_organism->field(OrganismField::MovementSpeed) = t_traits.getValue(TraitId::MovementSpeed);
 }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_MovementSpeed(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	t_organism->m_trait_movementSpeed = dynamic_cast<Trait_Float*>(t_trait)->getValue();
+void Trait_Base::TraitFn_TurningSpeed(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	t_organism->field(OrganismField::TurningSpeed) = t_traits.getValue(TraitId::TurningSpeed);
 }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_TurningSpeed(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	t_organism->m_trait_turningSpeed = dynamic_cast<Trait_Float*>(t_trait)->getValue();
+void Trait_Base::TraitFn_FoodDetectionRange(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	t_organism->field(OrganismField::FoodDetectionRange) = t_traits.getValue(TraitId::FoodDetectionRange);
 }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_Lifespan(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	t_organism->m_trait_lifespan = dynamic_cast<Trait_Float*>(t_trait)->getValue();
+void Trait_Base::TraitFn_Lifespan(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	t_organism->field(OrganismField::Lifespan) = t_traits.getValue(TraitId::Lifespan);
 }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_Size(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	t_organism->m_trait_size = dynamic_cast<Trait_Float*>(t_trait)->getValue();
-	t_organism->m_mass = 4.1887902f * std::powf(t_organism->m_trait_size * 0.5f,3.f); // mass : volume = (4/3)pi * (diameter/2)^3
-	t_organism->m_rmr = t_organism->m_mass * t_organism->m_trait_restingMetabolicRate;
-	t_organism->m_sprite.setScale(t_organism->m_trait_size, t_organism->m_trait_size);
+void Trait_Base::TraitFn_Size(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	const float size{ t_traits.getValue(TraitId::Size) };
+	t_organism->field(OrganismField::Size) = size;
+	t_organism->field(OrganismField::Mass) = 4.1887902f * std::pow(size * 0.5f,3.f); // mass : volume = (4/3)pi * (diameter/2)^3
+	t_organism->m_rmr = t_organism->getRestingMetabolicRate(); // The sprite takes the size when drawn
 }
 
 ////////////////////////////////////////////////////////////
-void Trait_Base::TraitFn_Color(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed) {
-	t_organism->setColor(dynamic_cast<Trait_Color*>(t_trait)->getColor());
+void Trait_Base::TraitFn_Color(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed) {
+	t_organism->setColor(t_traits.getColor());
 }
 
-// ------------------------------------------------------------- traits' implementation ------------------------------------------------------------------
\ No newline at end of file
+// ------------------------------------------------------------- traits' implementation ------------------------------------------------------------------
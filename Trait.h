@@ -1,29 +1,17 @@
 #ifndef TRAIT_H
 #define TRAIT_H
 
-#include <functional>
-#include <memory>
-#include <unordered_map>
-#include <unordered_set>
+#include <array>
+#include <string>
 #include <SFML/Graphics/Color.hpp>
 
 struct SharedContext;
 class Organism;
 class TraitCollection;
-class Trait_Base;
-class Trait_Float;
-class Trait_Color;
 enum class TraitId;
 enum class TraitEffectTime;
 
-using VitalTraits = std::unordered_set<TraitId>;
-using TraitStrings = std::unordered_map<std::string, TraitId>;
-using TraitPtr = std::unique_ptr<Trait_Base>;
-using TraitFunctor = void(*)(Trait_Base*, Organism*, const float&);
-using TraitCallback = std::function<void(Trait_Base*, Organism*, const float&)>;
-using TraitTable = std::unordered_map<TraitId , std::tuple<std::string, TraitCallback, TraitEffectTime>>;
-using TraitMap = std::unordered_map<TraitId, TraitPtr>;
-using TraitSet = std::unordered_set<TraitId>;
+using TraitFunctor = void(*)(const TraitCollection&, Organism*, const float&);
 
 
 enum class TraitId {
@@ -38,106 +26,63 @@ enum class TraitId {
 	FoodDetectionRange,		// (u)	    Distance at which the actor can detect food.
 	Lifespan,				// (s)		Natural living time of the strain.
 	Size,					// (u)		Size of the organism. Affects energy consumption.
-	Color
+	Color,
+	TRAIT_COUNT
 };
 enum class TraitEffectTime {
 	OnConstruction,		// Called at the organism's birth
 	Continuously		// Effect called every frame
 };
 
+enum class TraitType {
+	Float,
+	Color
+};
+
+struct TraitInfo {
+	std::string m_name;
+	TraitFunctor m_effect;			// The effect of the trait on its host; reads the trait's value from the host's collection
+	TraitEffectTime m_effectTime;	// Identifier for the moment at which the trait's effect is called
+	TraitType m_type;				// Which slot of the collection holds the trait's value
+	bool m_isVital;					// Every organism has it, and always passes it on
+};
 
+constexpr std::size_t NUM_TRAITS{ static_cast<std::size_t>(TraitId::TRAIT_COUNT) };
+using TraitTable = std::array<TraitInfo, NUM_TRAITS>;
 
+
+// Registry of the universal trait pool: what every potentially existant trait is and does, indexed by id.
+//	The values of the traits of an organism live in its TraitCollection.
 class Trait_Base {
-protected:
-	static const TraitTable s_traitNamesAndCallbacks; // Stores the string names of the trait and the bound callback
-	static const TraitMap s_defaultTraits;
-	static const TraitSet s_vitalTraits;
-	static const TraitSet s_floatTraits;
-	static const TraitSet s_colorTraits;
+	static const TraitTable s_traits;
 	static const float s_traitsStdDev; // Describes the height if the bell curve of percentual change when traits are inherited
 	static const float s_minTraitFactor;
 
 public:
-
+	static const TraitInfo& getTraitInfo(const TraitId& t_id);
 	static const std::string& getTraitName(const TraitId& t_id);
-	static TraitCallback getTraitCallback(const TraitId& t_id);
+	static TraitFunctor getTraitCallback(const TraitId& t_id);
 	static const TraitEffectTime& getTraitEffectTime(const TraitId& t_id);
 	static bool isTraitVital(const TraitId& t_id);
 	static bool isTraitFloat(const TraitId& t_id);
 	static bool isTraitColor(const TraitId& t_id);
-	static const TraitSet& getVitalTraits();
 	static const float& getTraitStdDev();
-	static TraitPtr cloneDefaultTrait(const TraitId& t_id);		// Returns perfect copy of a default trait
-	static TraitPtr reproduceDefaultTrait(SharedContext& t_context,const TraitId& t_id); // Returns a slightly altered copy of a default trait, as to simulate reproduction
-
-	Trait_Base(const TraitId& t_id, bool t_isActive, const float& t_inheritChance);
-
-	const TraitId& getId()const;
-	bool getIsActive()const;
-	void setIsActive(bool t_isActive);
-	bool getIsVital()const;
-	const float& getInheritChance()const;
-	void setInheritChance(const float& t_inheritChance);
-	const TraitEffectTime& getEffectTime()const;
-	void update(Organism* t_owner, const float& t_elapsed);
-
-	virtual TraitPtr clone()const = 0; // Creates perfect copy
-	virtual TraitPtr reproduce(SharedContext& t_context)const = 0; // Creates a copy based on reproduction system
-
-protected:
-	TraitId m_id;					// Trait id in the universal trait pool of all the potentially existant traits
-	bool m_isActive;				// Whether or not the trait affects the current instance of the strain (could be a dormant or epigenetic trait)
-	float m_inheritChance;			// Pct chance for the offspring to inherit the trait. All vital traits have 100% chance.
-	TraitEffectTime m_effectTime;	// Identifier for the moment at which the trait's effect is called
-	TraitCallback m_effect;			// The effect of the trait, which is exerted throug a callback to keep their potential broad.
-
-
-
+	static const float& getMinTraitFactor();
+	static const TraitCollection& getDefaultTraits(); // Every vital trait, with its default value
 
 private:
 	// --------------------------------------------- TRAITS ---------------------------------------------------------
-	static void TraitFn_MaxEnergy(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
-	static void TraitFn_DigestiveEfficiency(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
-	static void TraitFn_RestingMetabolicRate(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
-	static void TraitFn_MovementSpeed(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
-	static void TraitFn_TurningSpeed(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
-	static void TraitFn_Lifespan(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
-	static void TraitFn_Size(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
-
-	static void TraitFn_Color(Trait_Base* t_trait, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_MaxEnergy(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_DigestiveEfficiency(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_RestingMetabolicRate(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_MovementSpeed(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_TurningSpeed(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_FoodDetectionRange(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_Lifespan(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+	static void TraitFn_Size(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
+
+	static void TraitFn_Color(const TraitCollection& t_traits, Organism* t_organism, const float& t_elapsed);
 	// --------------------------------------------- traits ---------------------------------------------------------
 };
 
-class Trait_Float : public Trait_Base {
-
-	float m_value;					// Generic value used for anything the trait needs to affect the host
-public:
-	Trait_Float(const TraitId& t_id,
-		bool t_isActive,
-		const float& t_inheritChance,
-		const float& t_value);
-
-	const float& getValue()const;
-	void setValue(const float& t_value);
-
-	TraitPtr clone()const; 
-	TraitPtr reproduce(SharedContext& t_context)const;
-};
-
-class Trait_Color : public Trait_Base {
-
-	sf::Color m_color;
-public:
-	Trait_Color(const TraitId& t_id,
-		bool t_isActive,
-		const float& t_inheritChance,
-		const sf::Color& t_color);
-
-	const sf::Color& getColor()const;
-	void setColor(const sf::Color& t_color);
-
-	TraitPtr clone()const;
-	TraitPtr reproduce(SharedContext& t_context)const;
-};
-
-#endif // !TRAIT_H
\ No newline at end of file
+#endif // !TRAIT_H
@@ -1,240 +1,166 @@
 #include <algorithm>
-#include "TraitCollection.h"	
+#include "TraitCollection.h"
 #include "Organism.h"
-#include "Engine.h"
 #include "RandomGenerator.h"
+#include "HSLColor.h"
 
 
 ////////////////////////////////////////////////////////////
-TraitCollection::TraitCollection() {}
+TraitCollection::TraitCollection() : m_values{}, m_inheritChances{}, m_color{}, m_present{}, m_active{} {}
 
 ////////////////////////////////////////////////////////////
-void TraitCollection::update(Organism* t_owner, const float& t_elapsed) {
-	auto it{ m_traits.find(TraitEffectTime::Continuously) }; // Update only "continous" traits
-	if (it == m_traits.end()) { return; }
-	for (auto& t : it->second) {
-		if (t.second->getIsActive()) { t.second->update(t_owner, t_elapsed); }
+std::size_t TraitCollection::toIndex(const TraitId& t_id) { return static_cast<std::size_t>(t_id); }
+
+////////////////////////////////////////////////////////////
+void TraitCollection::callEffects(const TraitEffectTime& t_effectTime, Organism* t_owner, const float& t_elapsed)const {
+	const TraitMask enabled{ m_present & m_active };
+	for (std::size_t i{ 0U }; i < NUM_TRAITS; i++) {
+		if (!enabled[i]) { continue; }
+		const TraitInfo& info{ Trait_Base::getTraitInfo(static_cast<TraitId>(i)) };
+		if (info.m_effectTime == t_effectTime) { info.m_effect(*this, t_owner, t_elapsed); }
 	}
 }
 
 ////////////////////////////////////////////////////////////
-void TraitCollection::onOrganismConstruction(Organism* t_owner, const float& t_elapsed) {
-	auto it{ m_traits.find(TraitEffectTime::OnConstruction) }; // Update only "on construction" traits
-	if (it == m_traits.end()) { return; }
-	for (auto& t : it->second) {
-		if (t.second->getIsActive()) { t.second->update(t_owner, t_elapsed); }
-	}
+void TraitCollection::update(Organism* t_owner, const float& t_elapsed)const {
+	callEffects(TraitEffectTime::Continuously, t_owner, t_elapsed); // Update only "continous" traits
+}
+
+////////////////////////////////////////////////////////////
+void TraitCollection::onOrganismConstruction(Organism* t_owner, const float& t_elapsed)const {
+	callEffects(TraitEffectTime::OnConstruction, t_owner, t_elapsed); // Update only "on construction" traits
 }
 
 
 
 ////////////////////////////////////////////////////////////
-bool TraitCollection::hasTrait(const TraitId& t_id)const {
-	for (const auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) { return true; }
-	}
-	return false;
-}
+bool TraitCollection::hasTrait(const TraitId& t_id)const { return m_present[toIndex(t_id)]; }
 
 ////////////////////////////////////////////////////////////
 void TraitCollection::removeTrait(const TraitId& t_id) {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.end()) {
-			if (trait_it->second->getIsVital()) { return; } // Cannot remove a vital trait
-			traitTime_it.second.erase(trait_it);
-			return;
-		}
-	}
+	if (Trait_Base::isTraitVital(t_id)) { return; } // Cannot remove a vital trait
+	m_present[toIndex(t_id)] = false;
+	m_active[toIndex(t_id)] = false;
 }
 
 ////////////////////////////////////////////////////////////
-void TraitCollection::addTrait(TraitPtr t_trait) {
-	auto id{ t_trait->getId() };
-	auto et{ t_trait->getEffectTime() };
+bool TraitCollection::addTrait(const TraitId& t_id, bool t_isActive, const float& t_inheritChance, const float& t_value) {
+	if (!Trait_Base::isTraitFloat(t_id)) { return false; }
+	const std::size_t i{ toIndex(t_id) };
+	m_values[i] = t_value;
+	m_inheritChances[i] = t_inheritChance;
+	m_present[i] = true;
+	m_active[i] = t_isActive;
+	return true;
+}
 
-	auto traitTime_it{ m_traits.find(et) };
-	if (traitTime_it == m_traits.end()) {
-		TraitMap tmp;
-		tmp.emplace(id, std::move(t_trait));
-		m_traits.emplace(et, std::move(tmp));
-		return;
-	}
-	auto trait_it{ traitTime_it->second.find(id) };
-	if (trait_it == traitTime_it->second.end()) {
-		traitTime_it->second.emplace(id, std::move(t_trait));
-		return;
-	}
-	trait_it->second = std::move(t_trait);
+////////////////////////////////////////////////////////////
+bool TraitCollection::addTrait(const TraitId& t_id, bool t_isActive, const float& t_inheritChance, const sf::Color& t_color) {
+	if (!Trait_Base::isTraitColor(t_id)) { return false; }
+	const std::size_t i{ toIndex(t_id) };
+	m_color = t_color;
+	m_inheritChances[i] = t_inheritChance;
+	m_present[i] = true;
+	m_active[i] = t_isActive;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::setTraitValue(const TraitId& t_id, const float& t_value) {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			if (Trait_Base::isTraitFloat(t_id)) {
-				dynamic_cast<Trait_Float&>(*trait_it->second.get()).setValue(t_value);
-				return true;
-			}
-		}
-	}
-	return false;
+	if (!hasTrait(t_id) || !Trait_Base::isTraitFloat(t_id)) { return false; }
+	m_values[toIndex(t_id)] = t_value;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::getTraitValue(const TraitId& t_id, float& t_out_value)const {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			if (Trait_Base::isTraitFloat(t_id)) {
-				t_out_value = dynamic_cast<const Trait_Float&>(*trait_it->second.get()).getValue();
-				return true;
-			}
-		}
-	}
-	return false;
+	if (!hasTrait(t_id) || !Trait_Base::isTraitFloat(t_id)) { return false; }
+	t_out_value = m_values[toIndex(t_id)];
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::setTraitColor(const TraitId& t_id, const sf::Color& t_color) {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			if (Trait_Base::isTraitColor(t_id)) {
-				dynamic_cast<Trait_Color&>(*trait_it->second.get()).setColor(t_color);
-				return true;
-			}
-		}
-	}
-	return false;
+	if (!hasTrait(t_id) || !Trait_Base::isTraitColor(t_id)) { return false; }
+	m_color = t_color;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::getTraitColor(const TraitId& t_id, sf::Color& t_out_color)const {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			if (Trait_Base::isTraitFloat(t_id)) {
-				t_out_color = dynamic_cast<const Trait_Color&>(*trait_it->second.get()).getColor();
-				return true;
-			}
-		}
-	}
-	return false;
+	if (!hasTrait(t_id) || !Trait_Base::isTraitColor(t_id)) { return false; }
+	t_out_color = m_color;
+	return true;
 }
 
+////////////////////////////////////////////////////////////
+const float& TraitCollection::getValue(const TraitId& t_id)const { return m_values[toIndex(t_id)]; }
+
+////////////////////////////////////////////////////////////
+const sf::Color& TraitCollection::getColor()const { return m_color; }
+
 ////////////////////////////////////////////////////////////
 bool TraitCollection::isTraitActive(const TraitId& t_id, bool& t_out_isActive)const {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			t_out_isActive = trait_it->second->getIsActive();
-			return true;
-		}
-	}
-	return false;
+	if (!hasTrait(t_id)) { return false; }
+	t_out_isActive = m_active[toIndex(t_id)];
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::activateTrait(const TraitId& t_id) {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			trait_it->second->setIsActive(true);
-			return true;
-		}
-	}
-	return false;
+	if (!hasTrait(t_id)) { return false; }
+	m_active[toIndex(t_id)] = true;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::deactivateTrait(const TraitId& t_id) {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			trait_it->second->setIsActive(false);
-			return true;
-		}
-	}
-	return false;
+	if (!hasTrait(t_id)) { return false; }
+	m_active[toIndex(t_id)] = false;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::getTraitInheritChance(const TraitId& t_id, float& t_out_inheritChance)const {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			t_out_inheritChance = trait_it->second->getInheritChance();
-			return true;
-		}
-	}
-	return false;
+	if (!hasTrait(t_id)) { return false; }
+	t_out_inheritChance = m_inheritChances[toIndex(t_id)];
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
 bool TraitCollection::setTraitInheritChance(const TraitId& t_id, const float& t_inheritChance) {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			trait_it->second->setInheritChance(t_inheritChance);
-			return true;
-		}
-	}
-	return false;
-}
-
-////////////////////////////////////////////////////////////
-const Trait_Base* TraitCollection::getTrait(const TraitId& t_id)const {
-	for (const auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			return trait_it->second.get();
-		}
-	}
-	return nullptr;
+	if (!hasTrait(t_id)) { return false; }
+	m_inheritChances[toIndex(t_id)] = t_inheritChance;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////
-Trait_Base* TraitCollection::getTrait(const TraitId& t_id) {
-	for (auto& traitTime_it : m_traits) {
-		auto trait_it{ traitTime_it.second.find(t_id) };
-		if (trait_it != traitTime_it.second.cend()) {
-			return trait_it->second.get();
-		}
-	}
-	return nullptr;
-}
-
-////////////////////////////////////////////////////////////
-void TraitCollection::purge() { m_traits.clear(); }
-
-////////////////////////////////////////////////////////////
-TraitCollectionPtr TraitCollection::clone() {
-	auto copy{ std::make_unique<TraitCollection>() };
-	for (const auto& et_it : m_traits) {
-		for (const auto& id_it : et_it.second) {
-			copy->addTrait(std::move(id_it.second->clone()));
-		}
-	}
-	return std::move(copy);
+void TraitCollection::purge() {
+	m_present.reset();
+	m_active.reset();
 }
 
 
 //////////////////////////////////////////////////////////
-TraitCollectionPtr TraitCollection::reproduce(SharedContext& t_context) {
-	auto copy{ std::make_unique<TraitCollection>() };
-	for (const auto& traitTime_it : m_traits) {
-		for (const auto& trait_it : traitTime_it.second) {
-			float pctChance{ trait_it.second->getInheritChance() };
-			if (pctChance >= 1.f || pctChance > t_context.m_rng->generate(0.f, 1.f)) {
-				copy->addTrait(std::move(trait_it.second->reproduce(t_context)));
-			}
+void TraitCollection::reproduce(SharedContext& t_context, TraitCollection& t_out_offspring)const {
+	t_out_offspring = *this; // Keeps the activation and inherit chances of the parent
+	t_out_offspring.m_present.reset();
+	for (std::size_t i{ 0U }; i < NUM_TRAITS; i++) {
+		if (!m_present[i]) { continue; }
+		const float pctChance{ m_inheritChances[i] };
+		if (pctChance < 1.f && pctChance <= t_context.m_rng->generate(0.f, 1.f)) { continue; }
+		t_out_offspring.m_present[i] = true;
+
+		if (Trait_Base::isTraitColor(static_cast<TraitId>(i))) {
+			const float hueFactor{ t_context.m_rng->normalDisttribution(1.f, Trait_Base::getTraitStdDev()) }; // For colors, the normal distribution changes the hue value
+			auto hsl{ HSL::TurnToHSL(m_color) };
+			hsl.Hue *= hueFactor;
+			t_out_offspring.m_color = hsl.TurnToRGB();
+		}
+		else {
+			const float factor{ t_context.m_rng->normalDisttribution(1.f, Trait_Base::getTraitStdDev()) };
+			t_out_offspring.m_values[i] = m_values[i] * std::max(factor, Trait_Base::getMinTraitFactor());
 		}
 	}
-	return std::move(copy);
+	t_out_offspring.m_active &= t_out_offspring.m_present;
 }
-
-
-// ----------------------------------------------------------------------- TRAITS ----------------------------------------------------------------------
\ No newline at end of file
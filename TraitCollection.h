@@ -1,39 +1,42 @@
 #ifndef TRAITS_H
 #define TRAITS_H
 
-#include <memory>
-#include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <array>
+#include <bitset>
+#include <type_traits>
 #include "Trait.h"
 #include "SharedContext.h"
 
 
-using TraitCollectionPtr = std::unique_ptr<TraitCollection>;
-using TraitsMap = std::unordered_map<TraitId, TraitPtr>; // Group by id
-using TraitsContainer = std::unordered_map<TraitEffectTime, TraitsMap>; // Subdivide by effect time
+using TraitValues = std::array<float, NUM_TRAITS>;
+using TraitMask = std::bitset<NUM_TRAITS>;
 
+// The genome of an organism: the value of every trait, indexed by trait id, in a flat block of memory.
+//	Copying a collection is a plain memory copy; what the traits do lives in Trait_Base.
 class TraitCollection {
 
-	TraitsContainer m_traits;
+	TraitValues m_values;			// Value of the float traits
+	TraitValues m_inheritChances;
+	sf::Color m_color;				// Value of the color trait
+	TraitMask m_present;
+	TraitMask m_active;
 
 public:
-	static const std::string& traitIdToStr(const TraitId& t_id);
-	static TraitId traitStrToId(const std::string& t_str);
-	static bool isTraitVital(const TraitId& t_id);
-	static const VitalTraits& getVitalTraits();
-
 	TraitCollection();
 
 	bool hasTrait(const TraitId& t_id)const;
 	void removeTrait(const TraitId& t_id); // Fails if trait is vital (does nothing if trait is not present)
-	void addTrait(TraitPtr t_trait); // Overwrites any existent trait in the same slot
+	bool addTrait(const TraitId& t_id, bool t_isActive, const float& t_inheritChance, const float& t_value); // Overwrites any existent trait in the same slot; fails if the trait isn't a float
+	bool addTrait(const TraitId& t_id, bool t_isActive, const float& t_inheritChance, const sf::Color& t_color); // Overwrites any existent trait in the same slot; fails if the trait isn't a color
 
 	bool setTraitValue(const TraitId& t_id, const float& t_value);
 	bool getTraitValue(const TraitId& t_id, float& t_out_value)const;
 	bool setTraitColor(const TraitId& t_id, const sf::Color& t_color);
 	bool getTraitColor(const TraitId& t_id, sf::Color& t_out_color)const;
 
+	const float& getValue(const TraitId& t_id)const; // Unchecked; for the trait effects, which know their trait is present
+	const sf::Color& getColor()const; // Unchecked
+
 	bool isTraitActive(const TraitId& t_id, bool& t_out_isActive)const;
 	bool activateTrait(const TraitId& t_id); // Returns the finding result of the trait
 	bool deactivateTrait(const TraitId& t_id); // Returns the finding result of the trait
@@ -41,19 +44,17 @@ public:
 	bool getTraitInheritChance(const TraitId& t_id, float& t_out_inheritChance)const;
 	bool setTraitInheritChance(const TraitId& t_id, const float& t_inheritChance);
 
-	const Trait_Base* getTrait(const TraitId& t_id)const;
-	Trait_Base* getTrait(const TraitId& t_id);
-
 	void purge();
 
-	void onOrganismConstruction(Organism* t_owner, const float& t_elapsed); // Calls the update methods of construction based traits (mainly value setters)
-	void update(Organism* t_owner, const float& t_elapsed); // Calls the update function every trait
-	TraitCollectionPtr clone(); // Retrns perfect copy of the set of traits
-	TraitCollectionPtr reproduce(SharedContext& t_context); // Produces an offspring of the set of traits affected by their chance to be passed
-
-
-
+	void onOrganismConstruction(Organism* t_owner, const float& t_elapsed)const; // Calls the update methods of construction based traits (mainly value setters)
+	void update(Organism* t_owner, const float& t_elapsed)const; // Calls the update function every trait
+	void reproduce(SharedContext& t_context, TraitCollection& t_out_offspring)const; // Writes an offspring of the set of traits affected by their chance to be passed
 
+private:
+	static std::size_t toIndex(const TraitId& t_id);
+	void callEffects(const TraitEffectTime& t_effectTime, Organism* t_owner, const float& t_elapsed)const;
 };
 
-#endif // !TRAIT_H
\ No newline at end of file
+static_assert(std::is_trivially_copyable<TraitCollection>::value, "TraitCollection must stay a flat block of memory");
+
+#endif // !TRAITS_H
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -16,6 +17,10 @@
 #include <Windows.h>
 #include <pathcch.h>
 
+#else
+
+#include <unistd.h>
+
 #endif // WINDOWS 
 
 namespace utilities {
@@ -31,27 +36,47 @@ namespace utilities {
 		return std::move(path);
 	}
 
+#else
 
 	////////////////////////////////////////////////////////////
-	inline std::vector<std::pair<std::string, bool>> getFileList(const std::string& t_directory, const std::string& t_search = "*.*", bool t_directories = false) {
-		std::vector<std::pair<std::string, bool>> files;
-		if (t_search.empty()) { return std::move(files); }
-		std::string path{ t_directory + t_search };
-		WIN32_FIND_DATA data;
-		HANDLE found{ FindFirstFile(path.c_str(), &data) };
-		if (found == INVALID_HANDLE_VALUE) { return std::move(files); }
-		do {
-			if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) || t_directories) {
-				files.emplace_back(std::make_pair(std::string(data.cFileName),
-					((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)));
-			}
-		} while (FindNextFile(found, &data));
-		FindClose(found);
-		return std::move(files);
+	inline std::string getWorkingDirectory() { // Directory of the executable, like on Windows; the current one if it can't be found
+		std::vector<char> buff(4096U);
+		const ssize_t length{ readlink("/proc/self/exe", buff.data(), buff.size() - 1U) };
+		std::string path;
+		if (length > 0) {
+			path.assign(buff.data(), static_cast<std::size_t>(length));
+			path = path.substr(0, path.find_last_of('/') + 1);
+		}
+		else if (getcwd(buff.data(), buff.size())) { path = std::string(buff.data()) + '/'; }
+		assert(!path.empty() && "utilities::getWorkingDirectory: Returned empty string as path.");
+		return std::move(path);
 	}
 
 #endif // WINDOWS 
 
+	////////////////////////////////////////////////////////////
+	inline bool matchesWildcard(const char* t_name, const char* t_pattern) { // '*' is any run of characters, '?' any single one
+		if (*t_pattern == '\0') { return *t_name == '\0'; }
+		if (*t_pattern == '*') { return matchesWildcard(t_name, t_pattern + 1) || (*t_name != '\0' && matchesWildcard(t_name + 1, t_pattern)); }
+		return *t_name != '\0' && (*t_pattern == '?' || *t_pattern == *t_name) && matchesWildcard(t_name + 1, t_pattern + 1);
+	}
+
+	////////////////////////////////////////////////////////////
+	inline std::vector<std::pair<std::string, bool>> getFileList(const std::string& t_directory, const std::string& t_search = "*.*", bool t_directories = false) {
+		std::vector<std::pair<std::string, bool>> files;
+		if (t_search.empty()) { return files; }
+		const std::string pattern{ t_search == "*.*" ? "*" : t_search }; // Like on Windows, *.* also matches names without an extension
+		std::error_code error;
+		for (std::filesystem::directory_iterator it{ t_directory, error }, end; !error && it != end; it.increment(error)) {
+			const std::string name{ it->path().filename().string() };
+			if (!matchesWildcard(name.c_str(), pattern.c_str())) { continue; }
+			std::error_code statusError;
+			const bool isDirectory{ it->is_directory(statusError) };
+			if (!isDirectory || t_directories) { files.emplace_back(name, isDirectory); }
+		}
+		return files;
+	}
+
 	const std::string EMPTY_STR{ "" };
 
 	////////////////////////////////////////////////////////////
@@ -79,6 +104,7 @@ namespace utilities {
 	inline float getSFMLTextMaxHeight(const sf::Text& t_text) {
 		auto charSize{ t_text.getCharacterSize() };
 		auto font{ t_text.getFont() };
+		if (!font) { return 0.f; } // No font, no glyphs
 		auto string{ t_text.getString().toAnsiString() };
 		bool bold{ (bool)(t_text.getStyle() & sf::Text::Bold) };
 		float max{ 0.f };
@@ -0,0 +1,15 @@
+#include <string>
+#include "BenchmarkSuite.h"
+#include "BroadPhaseBenchmark.h"
+
+// Benchmark runner; also the training workload of profile guided builds
+int main(int argc, char* argv[]) {
+
+	// Usage: [<results file>] | --broadphase
+	const std::string arg{ argc >= 2 ? argv[1] : "benchmark.json" };
+	if (arg == "--broadphase") {
+		runBroadPhaseBenchmark();
+		return 0;
+	}
+	return runBenchmarkSuite(arg) ? 0 : 1;
+}
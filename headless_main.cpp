@@ -0,0 +1,16 @@
+#include <iostream>
+#include <string>
+#include "RunOptions.h"
+
+// Headless runner, for servers without a display
+int main(int argc, char* argv[]) {
+
+	// Usage: <ticks> [<run options, see RunOptions.h>]
+	if (argc < 2) {
+		std::cerr << "@ ERROR: Usage: " << argv[0] << " <ticks> [--seed <seed>] [--threads <workers>] [--load <file>] [--save <file>] [--telemetry <file>] [--profile <file>]!" << std::endl;
+		return 1;
+	}
+	RunOptions options;
+	if (!RunOptions::parseCount("<ticks>", argv[1], options.m_ticks) || !options.parse(argc, argv, 2)) { return 1; }
+	return runHeadless(options);
+}
@@ -1,14 +1,28 @@
 #include <iostream>
-#include "Engine.h"
+#include <string>
+#include "BenchmarkSuite.h"
+#include "BroadPhaseBenchmark.h"
+#include "RunOptions.h"
+#include "TelemetryWriter.h"
 
-int main() {
+int main(int argc, char* argv[]) {
 
-	Engine engine{ sf::Vector2u(1080,1080),"Test" };
-	engine.run();
+	// Usage: --benchmark-broadphase | --benchmark <results file> | --telemetry-to-csv <telemetry file> <csv file> | <run options, see RunOptions.h>
+	if (argc >= 2 && std::string(argv[1]) == "--benchmark-broadphase") {
+		runBroadPhaseBenchmark();
+		return 0;
+	}
+	if (argc >= 3 && std::string(argv[1]) == "--benchmark") { return runBenchmarkSuite(argv[2]) ? 0 : 1; }
+	if (argc >= 4 && std::string(argv[1]) == "--telemetry-to-csv") { return TelemetryWriter::convertToCsv(argv[2], argv[3]) ? 0 : 1; }
+
+	RunOptions options;
+	if (!options.parse(argc, argv)) { return 1; }
+	if (options.m_isHeadless) { return runHeadless(options); }
+	const int result{ runWindowed(options) };
 
 #ifdef _DEBUG
 	std::cout << "> Exited at main" << std::endl;
 #endif // _DEBUG
 
-	return 0;
-}
\ No newline at end of file
+	return result;
+}